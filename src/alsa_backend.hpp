@@ -0,0 +1,131 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <alsa/asoundlib.h>
+
+namespace TotalMixer {
+
+enum class ControlType { Bool, Int, Enum, Other };
+
+struct ControlInfo {
+    std::string type; // "Bool", "Int", "Enum", "Other"
+    ControlType kind = ControlType::Other;
+    long min = 0;
+    long max = 0;
+    std::vector<std::string> enum_items;
+    unsigned int count = 0;
+    unsigned int numid = 0;
+    int iface = -1;
+    bool writable = false;
+};
+
+// A control element resolved once by name. Holds everything the read/write path needs, so
+// calls through a handle do no name lookup, string compare or allocation. Valid until the
+// element is removed (e.g. the service restarts); after that calls on it fail and the owner
+// resolves it again.
+struct ControlHandle {
+    unsigned int numid = 0; // 0 = unresolved
+    int iface = -1;
+    ControlType type = ControlType::Other;
+    unsigned int count = 0;
+    long min = 0;
+    long max = 0;
+    int shadow = -1; // AlsaCore shadow slot for writable multi-element controls, else -1
+
+    bool valid() const { return numid != 0; }
+};
+
+// Helper variant-like structure to hold return values
+struct ControlValue {
+    std::vector<long> int_values;
+    std::string enum_string; 
+    bool is_enum = false;
+    
+    // Helpers
+    long as_int() const { return int_values.empty() ? 0 : int_values[0]; }
+    const std::vector<long>& as_array() const { return int_values; }
+    std::string as_string() const { return enum_string; }
+};
+
+// A batch of element edits on multi-element controls (matrix crosspoints). set() only records
+// the edit; AlsaCore::commit groups them by control row and writes each touched row once, with
+// later edits of the same element winning.
+class MatrixTransaction {
+public:
+    void set(const ControlHandle& row, unsigned int element, long value) {
+        edits.push_back({row, element, value});
+    }
+    bool empty() const { return edits.empty(); }
+    size_t size() const { return edits.size(); }
+    void clear() { edits.clear(); }
+
+    struct Edit {
+        ControlHandle row;
+        unsigned int element;
+        long value;
+    };
+    // Recorded edits in call order, for backends implementing commit().
+    const std::vector<Edit>& pending() const { return edits; }
+
+private:
+    std::vector<Edit> edits;
+};
+
+// One notification drained from the card's control event stream. Carries the element's numid
+// so it can be matched against resolved ControlHandles without touching its name.
+struct ControlEvent {
+    unsigned int numid = 0;
+    unsigned int index = 0;
+    unsigned int mask = 0; // SND_CTL_EVENT_MASK_* bits
+
+    // REMOVE is reported as an all-ones mask rather than a bit of its own.
+    bool removed() const { return mask == SND_CTL_EVENT_MASK_REMOVE; }
+    bool value_changed() const { return !removed() && (mask & SND_CTL_EVENT_MASK_VALUE); }
+};
+
+// The control-element surface MixerEngine and the GUI need from a sound card. AlsaCore is the
+// real implementation (hw:N through alsa-lib); FakeFireface simulates a Fireface 400 in memory
+// so the engine can run, and be profiled, without the hardware or snd-fireface-ctl.
+class AlsaBackend {
+public:
+    virtual ~AlsaBackend() = default;
+
+    virtual std::string get_card_name() = 0;
+    virtual std::optional<ControlInfo> get_control_info(const std::string& name, unsigned int index = 0) = 0;
+
+    // ── Resolved-handle access (hot path) ──
+    // resolve() does the name lookup once. The handle calls address the element by numid.
+    virtual std::optional<ControlHandle> resolve(const std::string& name, unsigned int index = 0) = 0;
+    // Reads up to max_count elements into out (enum index for Enum controls). Returns the
+    // number of elements read, or -1 on failure. Always asks the hardware.
+    virtual int read(const ControlHandle& h, long* out, unsigned int max_count) = 0;
+    // Same as read(), but a backend that keeps a current copy of the element may serve it
+    // without an ALSA call.
+    virtual int read_cached(const ControlHandle& h, long* out, unsigned int max_count) { return read(h, out, max_count); }
+    // Writes values[0..count). A partial write (count < h.count) preserves the other elements.
+    virtual bool write(const ControlHandle& h, const long* values, unsigned int count) = 0;
+    bool write(const ControlHandle& h, long value) { return write(h, &value, 1); }
+    // Writes a single element of a multi-element control (matrix crosspoint).
+    virtual bool write_element(const ControlHandle& h, unsigned int element, long value) = 0;
+    // Writes every row touched by txn with a single element write each, then clears txn.
+    // Returns false if any row failed (the remaining rows are still attempted).
+    virtual bool commit(MatrixTransaction& txn) = 0;
+
+    // Control change notifications. After subscribe_events(), read_events() returns whatever is
+    // queued without ever waiting.
+    virtual bool subscribe_events() = 0;
+    virtual bool events_subscribed() const = 0;
+    // Replaces the contents of out with the pending events; reuses out's capacity. Returns the count.
+    virtual size_t read_events(std::vector<ControlEvent>& out) = 0;
+    // A descriptor that polls readable while read_events() has something to return, so an event
+    // loop can sleep until the card changes. -1 if there is none (not subscribed, or the backend
+    // cannot provide one); the caller then has to poll on a timer.
+    virtual int event_fd() const { return -1; }
+    // True once the event stream has failed for good (card unplugged, service gone): the
+    // connection is dead, and event_fd() is -1 from then on.
+    virtual bool events_lost() const { return false; }
+};
+
+} // namespace TotalMixer
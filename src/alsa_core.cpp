@@ -5,6 +5,8 @@
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <cerrno>
+#include <mutex>
 
 namespace TotalMixer {
 
@@ -37,15 +39,19 @@ AlsaCore::~AlsaCore() {
 void AlsaCore::allocate_resources() {
     snd_ctl_elem_id_malloc(&id_ptr);
     snd_ctl_elem_value_malloc(&val_ptr);
+    snd_ctl_elem_value_malloc(&handle_val_ptr);
     snd_ctl_elem_info_malloc(&info_ptr);
     snd_ctl_card_info_malloc(&card_info_ptr);
+    snd_ctl_event_malloc(&event_ptr);
 }
 
 void AlsaCore::free_resources() {
     if (id_ptr) { snd_ctl_elem_id_free(id_ptr); id_ptr = nullptr; }
     if (val_ptr) { snd_ctl_elem_value_free(val_ptr); val_ptr = nullptr; }
+    if (handle_val_ptr) { snd_ctl_elem_value_free(handle_val_ptr); handle_val_ptr = nullptr; }
     if (info_ptr) { snd_ctl_elem_info_free(info_ptr); info_ptr = nullptr; }
     if (card_info_ptr) { snd_ctl_card_info_free(card_info_ptr); card_info_ptr = nullptr; }
+    if (event_ptr) { snd_ctl_event_free(event_ptr); event_ptr = nullptr; }
 }
 
 int AlsaCore::find_fireface_card() {
@@ -66,6 +72,7 @@ int AlsaCore::find_fireface_card() {
 }
 
 std::string AlsaCore::get_card_name() {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
     if (!handle || snd_ctl_card_info(handle, card_info_ptr) < 0) {
         return "Unknown Device";
     }
@@ -73,6 +80,7 @@ std::string AlsaCore::get_card_name() {
 }
 
 std::vector<std::pair<std::string, unsigned int>> AlsaCore::list_all_controls() {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
     std::vector<std::pair<std::string, unsigned int>> controls;
     if (!handle) return controls;
 
@@ -131,6 +139,7 @@ int AlsaCore::_find_iface(const std::string& name) {
 }
 
 std::optional<ControlInfo> AlsaCore::get_control_info(const std::string& name, unsigned int index) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
     if (ctl_info_cache.find({name, index}) != ctl_info_cache.end()) {
         return ctl_info_cache[{name, index}];
     }
@@ -152,14 +161,17 @@ std::optional<ControlInfo> AlsaCore::get_control_info(const std::string& name, u
     ControlInfo result;
     snd_ctl_elem_type_t type = snd_ctl_elem_info_get_type(info_ptr);
     
-    if (type == SND_CTL_ELEM_TYPE_BOOLEAN) result.type = "Bool";
-    else if (type == SND_CTL_ELEM_TYPE_INTEGER) result.type = "Int";
-    else if (type == SND_CTL_ELEM_TYPE_ENUMERATED) result.type = "Enum";
-    else result.type = "Other";
+    if (type == SND_CTL_ELEM_TYPE_BOOLEAN) { result.type = "Bool"; result.kind = ControlType::Bool; }
+    else if (type == SND_CTL_ELEM_TYPE_INTEGER) { result.type = "Int"; result.kind = ControlType::Int; }
+    else if (type == SND_CTL_ELEM_TYPE_ENUMERATED) { result.type = "Enum"; result.kind = ControlType::Enum; }
+    else { result.type = "Other"; result.kind = ControlType::Other; }
 
     result.min = snd_ctl_elem_info_get_min(info_ptr);
     result.max = snd_ctl_elem_info_get_max(info_ptr);
     result.count = snd_ctl_elem_info_get_count(info_ptr);
+    result.numid = snd_ctl_elem_info_get_numid(info_ptr);
+    result.iface = iface;
+    result.writable = snd_ctl_elem_info_is_writable(info_ptr) != 0;
 
     if (type == SND_CTL_ELEM_TYPE_ENUMERATED) {
         unsigned int items = snd_ctl_elem_info_get_items(info_ptr);
@@ -177,6 +189,7 @@ std::optional<ControlInfo> AlsaCore::get_control_info(const std::string& name, u
 }
 
 std::optional<ControlValue> AlsaCore::get_control_value(const std::string& name, unsigned int index) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
     int iface = _find_iface(name);
     if (iface == -1) return std::nullopt;
 
@@ -193,7 +206,7 @@ std::optional<ControlValue> AlsaCore::get_control_value(const std::string& name,
 
     ControlValue result;
     
-    if (info.type == "Enum") {
+    if (info.kind == ControlType::Enum) {
         result.is_enum = true;
         unsigned int idx = snd_ctl_elem_value_get_enumerated(val_ptr, 0);
         if (idx < info.enum_items.size()) {
@@ -211,6 +224,7 @@ std::optional<ControlValue> AlsaCore::get_control_value(const std::string& name,
 }
 
 bool AlsaCore::set_control_value(const std::string& name, unsigned int index, long value) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
     int iface = _find_iface(name);
     if (iface == -1) return false;
 
@@ -227,12 +241,13 @@ bool AlsaCore::set_control_value(const std::string& name, unsigned int index, lo
 }
 
 bool AlsaCore::set_control_value(const std::string& name, unsigned int index, const std::string& enum_value) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
     int iface = _find_iface(name);
     if (iface == -1) return false;
 
     // Get info to find enum index
     auto info_opt = get_control_info(name, index);
-    if (!info_opt || info_opt->type != "Enum") return false;
+    if (!info_opt || info_opt->kind != ControlType::Enum) return false;
 
     auto it = std::find(info_opt->enum_items.begin(), info_opt->enum_items.end(), enum_value);
     long idx = 0;
@@ -258,24 +273,16 @@ bool AlsaCore::set_control_value(const std::string& name, unsigned int index, co
 }
 
 bool AlsaCore::set_control_value(const std::string& name, unsigned int index, const std::vector<long>& values) {
-    int iface = _find_iface(name);
-    if (iface == -1) return false;
-
-    snd_ctl_elem_id_set_interface(id_ptr, (snd_ctl_elem_iface_t)iface);
-    snd_ctl_elem_id_set_name(id_ptr, name.c_str());
-    snd_ctl_elem_id_set_index(id_ptr, index);
-    
-    snd_ctl_elem_value_set_id(val_ptr, id_ptr);
-    snd_ctl_elem_read(handle, val_ptr); // Read existing state
-
-    for (size_t i = 0; i < values.size(); ++i) {
-        snd_ctl_elem_value_set_integer(val_ptr, i, values[i]);
-    }
-
-    return snd_ctl_elem_write(handle, val_ptr) >= 0;
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+    // Goes through the handle path so the untouched elements come from the shadow copy
+    // instead of a fresh read.
+    auto h = resolve(name, index);
+    if (!h) return false;
+    return write(*h, values.data(), static_cast<unsigned int>(values.size()));
 }
 
 std::optional<std::vector<long>> AlsaCore::get_matrix_row(const std::string& name, unsigned int index, unsigned int /*count*/) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
     // In Python this was just alias for get_control_value, but here get_control_value returns struct.
     // Python: return self.get_control_value(name, index) -> returns list
     auto val = get_control_value(name, index);
@@ -284,27 +291,271 @@ std::optional<std::vector<long>> AlsaCore::get_matrix_row(const std::string& nam
 }
 
 bool AlsaCore::set_matrix_gain(const std::string& name, unsigned int alsa_ctrl_idx, unsigned int element_idx, long val) {
-    auto current_opt = get_control_value(name, alsa_ctrl_idx);
-    if (!current_opt) {
-        std::cerr << "set_matrix_gain: get_control_value failed for " << name << "[" << alsa_ctrl_idx << "]" << std::endl;
-        return false;
-    }
-    
-    std::vector<long> current = current_opt->int_values;
-    if (element_idx >= current.size()) {
-        std::cerr << "set_matrix_gain: element_idx " << element_idx << " >= size " << current.size() << std::endl;
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+    auto h = resolve(name, alsa_ctrl_idx);
+    if (!h) {
+        std::cerr << "set_matrix_gain: resolve failed for " << name << "[" << alsa_ctrl_idx << "]" << std::endl;
         return false;
     }
-    
-    current[element_idx] = val;
-    bool result = set_control_value(name, alsa_ctrl_idx, current);
+
+    bool result = write_element(*h, element_idx, val);
     if (!result) {
-        std::cerr << "set_matrix_gain: set_control_value failed for " << name << "[" << alsa_ctrl_idx << "] element " << element_idx << std::endl;
+        std::cerr << "set_matrix_gain: write_element failed for " << name << "[" << alsa_ctrl_idx << "] element " << element_idx << std::endl;
     }
     return result;
 }
 
+std::optional<ControlHandle> AlsaCore::resolve(const std::string& name, unsigned int index) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+    auto info = get_control_info(name, index);
+    if (!info || info->numid == 0) return std::nullopt;
+
+    ControlHandle h;
+    h.numid = info->numid;
+    h.iface = info->iface;
+    h.type = info->kind;
+    h.count = info->count;
+    h.min = info->min;
+    h.max = info->max;
+
+    if (info->writable && info->count > 1) {
+        if (h.numid >= shadow_by_numid.size()) shadow_by_numid.resize(h.numid + 1, -1);
+        int& slot = shadow_by_numid[h.numid];
+        if (slot < 0) {
+            slot = static_cast<int>(shadows.size());
+            shadows.emplace_back();
+            shadows.back().values.resize(h.count);
+        }
+        h.shadow = slot;
+        shadows[slot].ctl = h;
+    }
+    return h;
+}
+
+AlsaCore::ShadowRow* AlsaCore::_shadow(const ControlHandle& h) {
+    if (h.shadow < 0 || h.shadow >= static_cast<int>(shadows.size())) return nullptr;
+    ShadowRow& sh = shadows[h.shadow];
+    return sh.ctl.numid == h.numid ? &sh : nullptr; // stale handle from before a re-resolve
+}
+
+// Copies handle_val_ptr (just read, or just written in full) into h's shadow.
+void AlsaCore::_capture_shadow(const ControlHandle& h) {
+    ShadowRow* sh = _shadow(h);
+    if (!sh) return;
+    if (h.type == ControlType::Enum) {
+        for (unsigned int i = 0; i < h.count; ++i) sh->values[i] = snd_ctl_elem_value_get_enumerated(handle_val_ptr, i);
+    } else {
+        for (unsigned int i = 0; i < h.count; ++i) sh->values[i] = snd_ctl_elem_value_get_integer(handle_val_ptr, i);
+    }
+    sh->valid = true;
+}
+
+void AlsaCore::_drop_shadow(const ControlHandle& h) {
+    if (ShadowRow* sh = _shadow(h)) sh->valid = false;
+}
+
+// A shadow is only authoritative while control events keep it current. Without them (the
+// subscription failed, or the stream died) nothing tells us about other clients' writes between
+// polls, so every caller goes back to the hardware.
+AlsaCore::ShadowRow* AlsaCore::_current_shadow(const ControlHandle& h) {
+    if (!events_enabled || events_failed) return nullptr;
+    ShadowRow* sh = _shadow(h);
+    return sh && sh->valid ? sh : nullptr;
+}
+
+// Fills handle_val_ptr with h's current contents ahead of a partial write: from the shadow
+// when it is current, otherwise from the hardware (read-modify-write).
+bool AlsaCore::_load_row(const ControlHandle& h) {
+    ShadowRow* sh = _current_shadow(h);
+    if (!sh) return _read_handle(h);
+
+    snd_ctl_elem_value_set_numid(handle_val_ptr, h.numid);
+    if (h.type == ControlType::Enum) {
+        for (unsigned int i = 0; i < h.count; ++i) snd_ctl_elem_value_set_enumerated(handle_val_ptr, i, sh->values[i]);
+    } else {
+        for (unsigned int i = 0; i < h.count; ++i) snd_ctl_elem_value_set_integer(handle_val_ptr, i, sh->values[i]);
+    }
+    return true;
+}
+
+// Loads handle_val_ptr with the element's current value. Only the numid is set on the id: the
+// kernel looks an element up by numid first, so name/iface/index never need to be filled in.
+bool AlsaCore::_read_handle(const ControlHandle& h) {
+    if (!handle || !h.valid()) return false;
+    snd_ctl_elem_value_set_numid(handle_val_ptr, h.numid);
+    if (snd_ctl_elem_read(handle, handle_val_ptr) < 0) return false;
+    _capture_shadow(h);
+    return true;
+}
+
+int AlsaCore::read(const ControlHandle& h, long* out, unsigned int max_count) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+    if (!_read_handle(h)) return -1;
+
+    unsigned int n = h.count < max_count ? h.count : max_count;
+    if (h.type == ControlType::Enum) {
+        for (unsigned int i = 0; i < n; ++i) out[i] = snd_ctl_elem_value_get_enumerated(handle_val_ptr, i);
+    } else {
+        for (unsigned int i = 0; i < n; ++i) out[i] = snd_ctl_elem_value_get_integer(handle_val_ptr, i);
+    }
+    return static_cast<int>(n);
+}
+
+int AlsaCore::read_cached(const ControlHandle& h, long* out, unsigned int max_count) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+    ShadowRow* sh = _current_shadow(h);
+    if (!sh) return read(h, out, max_count);
+
+    unsigned int n = h.count < max_count ? h.count : max_count;
+    for (unsigned int i = 0; i < n; ++i) out[i] = sh->values[i];
+    return static_cast<int>(n);
+}
+
+bool AlsaCore::write(const ControlHandle& h, const long* values, unsigned int count) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+    if (!handle || !h.valid()) return false;
+    if (count > h.count) count = h.count;
+
+    if (count < h.count) {
+        if (!_load_row(h)) return false; // preserve the elements we are not writing
+    } else {
+        snd_ctl_elem_value_set_numid(handle_val_ptr, h.numid);
+    }
+
+    if (h.type == ControlType::Enum) {
+        for (unsigned int i = 0; i < count; ++i) snd_ctl_elem_value_set_enumerated(handle_val_ptr, i, values[i]);
+    } else {
+        for (unsigned int i = 0; i < count; ++i) snd_ctl_elem_value_set_integer(handle_val_ptr, i, values[i]);
+    }
+    if (snd_ctl_elem_write(handle, handle_val_ptr) < 0) {
+        _drop_shadow(h);
+        return false;
+    }
+    _capture_shadow(h);
+    return true;
+}
+
+bool AlsaCore::write_element(const ControlHandle& h, unsigned int element, long value) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+    if (element >= h.count) {
+        std::cerr << "write_element: element " << element << " >= size " << h.count << std::endl;
+        return false;
+    }
+    if (!_load_row(h)) return false;
+
+    if (h.type == ControlType::Enum) snd_ctl_elem_value_set_enumerated(handle_val_ptr, element, value);
+    else snd_ctl_elem_value_set_integer(handle_val_ptr, element, value);
+    if (snd_ctl_elem_write(handle, handle_val_ptr) < 0) {
+        _drop_shadow(h);
+        return false;
+    }
+    _capture_shadow(h);
+    return true;
+}
+
+bool AlsaCore::commit(MatrixTransaction& txn) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+    bool ok = true;
+    const auto& edits = txn.pending();
+    for (size_t i = 0; i < edits.size(); ++i) {
+        const ControlHandle& row = edits[i].row;
+
+        // Rows are committed in order of first appearance; skip one already written.
+        bool done = false;
+        for (size_t j = 0; j < i && !done; ++j) done = (edits[j].row.numid == row.numid);
+        if (done) continue;
+
+        if (!_load_row(row)) {
+            std::cerr << "commit: read failed for numid " << row.numid << std::endl;
+            ok = false;
+            continue;
+        }
+        for (size_t k = i; k < edits.size(); ++k) {
+            const auto& e = edits[k];
+            if (e.row.numid != row.numid || e.element >= row.count) continue;
+            if (row.type == ControlType::Enum) snd_ctl_elem_value_set_enumerated(handle_val_ptr, e.element, e.value);
+            else snd_ctl_elem_value_set_integer(handle_val_ptr, e.element, e.value);
+        }
+        if (snd_ctl_elem_write(handle, handle_val_ptr) < 0) {
+            std::cerr << "commit: write failed for numid " << row.numid << std::endl;
+            _drop_shadow(row);
+            ok = false;
+        } else {
+            _capture_shadow(row);
+        }
+    }
+    txn.clear();
+    return ok;
+}
+
+bool AlsaCore::subscribe_events() {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+    if (!handle) return false;
+    if (events_enabled) return true;
+
+    // Non-blocking only changes snd_ctl_read (-EAGAIN instead of sleeping); element
+    // reads and writes are ioctls and behave exactly as before.
+    if (snd_ctl_nonblock(handle, 1) < 0) return false;
+    if (snd_ctl_subscribe_events(handle, 1) < 0) {
+        snd_ctl_nonblock(handle, 0);
+        return false;
+    }
+    // A ctl handle has a single descriptor; it polls readable while events are queued.
+    struct pollfd pfd;
+    if (snd_ctl_poll_descriptors(handle, &pfd, 1) == 1) event_poll_fd = pfd.fd;
+    events_enabled = true;
+    return true;
+}
+
+size_t AlsaCore::read_events(std::vector<ControlEvent>& out) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+    out.clear();
+    if (!handle || !events_enabled || events_failed) return 0;
+
+    int err;
+    while ((err = snd_ctl_read(handle, event_ptr)) > 0) {
+        if (snd_ctl_event_get_type(event_ptr) != SND_CTL_EVENT_ELEM) continue;
+
+        ControlEvent ev;
+        ev.numid = snd_ctl_event_elem_get_numid(event_ptr);
+        ev.index = snd_ctl_event_elem_get_index(event_ptr);
+        ev.mask = snd_ctl_event_elem_get_mask(event_ptr);
+
+        // Added/removed/re-described elements invalidate what we cached about them (the
+        // service may have restarted and re-created its controls under new numids).
+        int slot = ev.numid < shadow_by_numid.size() ? shadow_by_numid[ev.numid] : -1;
+        if (!ev.value_changed()) {
+            std::string name = snd_ctl_event_elem_get_name(event_ptr);
+            ctl_iface_cache.erase(name);
+            ctl_info_cache.erase({name, ev.index});
+            if (slot >= 0) {
+                shadows[slot].valid = false;
+                shadows[slot].refresh = false;
+                if (ev.removed()) {
+                    shadows[slot].ctl.numid = 0; // handles into this slot stop matching
+                    shadow_by_numid[ev.numid] = -1;
+                }
+            }
+        } else if (slot >= 0) {
+            shadows[slot].refresh = true;
+        }
+        out.push_back(ev);
+    }
+    // -ENODEV (or any other hard error) once the card is gone; its descriptor then polls as an
+    // error forever, so stop handing it out.
+    if (err < 0 && err != -EAGAIN && err != -EINTR) events_failed = true;
+
+    // One read per changed row, however many events it produced in this drain.
+    for (auto& sh : shadows) {
+        if (!sh.refresh) continue;
+        sh.refresh = false;
+        if (!_read_handle(sh.ctl)) sh.valid = false;
+    }
+    return out.size();
+}
+
 AlsaCore::HwInfo AlsaCore::get_hw_info() {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
     HwInfo info = {"--", "--", 0};
     snd_pcm_t *pcm;
     // Try opening playback or capture stream to query params. "default" or "hw:X"
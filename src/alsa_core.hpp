@@ -5,46 +5,28 @@
 #include <map>
 #include <optional>
 #include <memory>
+#include <mutex>
 #include <alsa/asoundlib.h>
+#include "alsa_backend.hpp"
 
 namespace TotalMixer {
 
-struct ControlInfo {
-    std::string type; // "Bool", "Int", "Enum", "Other"
-    long min = 0;
-    long max = 0;
-    std::vector<std::string> enum_items;
-    unsigned int count = 0;
-};
-
-// Helper variant-like structure to hold return values
-struct ControlValue {
-    std::vector<long> int_values;
-    std::string enum_string; 
-    bool is_enum = false;
-    
-    // Helpers
-    long as_int() const { return int_values.empty() ? 0 : int_values[0]; }
-    const std::vector<long>& as_array() const { return int_values; }
-    std::string as_string() const { return enum_string; }
-};
-
-class AlsaCore {
+class AlsaCore : public AlsaBackend {
 public:
     // If card_index is -1 (or unspecified), it attempts to find "Fireface" automatically.
     explicit AlsaCore(int card_index = -1);
-    ~AlsaCore();
+    ~AlsaCore() override;
 
     // Disable copy/move to keep resource management simple for this port
     AlsaCore(const AlsaCore&) = delete;
     AlsaCore& operator=(const AlsaCore&) = delete;
 
-    std::string get_card_name();
+    std::string get_card_name() override;
     
     // Returns list of (name, index)
     std::vector<std::pair<std::string, unsigned int>> list_all_controls();
 
-    std::optional<ControlInfo> get_control_info(const std::string& name, unsigned int index = 0);
+    std::optional<ControlInfo> get_control_info(const std::string& name, unsigned int index = 0) override;
     std::optional<ControlValue> get_control_value(const std::string& name, unsigned int index = 0);
 
     bool set_control_value(const std::string& name, unsigned int index, long value);
@@ -55,6 +37,26 @@ public:
     std::optional<std::vector<long>> get_matrix_row(const std::string& name, unsigned int index, unsigned int count = 18);
     bool set_matrix_gain(const std::string& name, unsigned int alsa_ctrl_idx, unsigned int element_idx, long val);
 
+    // ── Resolved-handle access (AlsaBackend) ──
+    std::optional<ControlHandle> resolve(const std::string& name, unsigned int index = 0) override;
+    // read() also refreshes the handle's shadow copy; read_cached() serves the shadow when it
+    // is current (valid, with control events subscribed).
+    int read(const ControlHandle& h, long* out, unsigned int max_count) override;
+    int read_cached(const ControlHandle& h, long* out, unsigned int max_count) override;
+    using AlsaBackend::write;
+    bool write(const ControlHandle& h, const long* values, unsigned int count) override;
+    bool write_element(const ControlHandle& h, unsigned int element, long value) override;
+    bool commit(MatrixTransaction& txn) override;
+
+    // subscribe_events() switches the handle to non-blocking event reads. read_events() re-reads
+    // each shadowed control named by a value event once, so the shadow follows changes made by
+    // other clients (and the echo of our own writes).
+    bool subscribe_events() override;
+    bool events_subscribed() const override { return events_enabled; }
+    size_t read_events(std::vector<ControlEvent>& out) override;
+    int event_fd() const override { return events_enabled && !events_failed ? event_poll_fd : -1; }
+    bool events_lost() const override { return events_failed; }
+
     // Hardware Info Helper
     struct HwInfo {
         std::string rate_str;
@@ -64,19 +66,50 @@ public:
     HwInfo get_hw_info();
 
 private:
+    // Every public call holds this, so the engine thread and a frontend (meters, Control tab)
+    // can share one connection. Recursive because the name-based calls go through resolve().
+    std::recursive_mutex mtx;
+
     snd_ctl_t* handle = nullptr;
     int card_index = -1; 
     
     // We keep these allocated to avoid malloc/free on every call (like the Python script does)
     snd_ctl_elem_id_t* id_ptr = nullptr;
     snd_ctl_elem_value_t* val_ptr = nullptr;
+    snd_ctl_elem_value_t* handle_val_ptr = nullptr; // numid-addressed, used only by handle calls
     snd_ctl_elem_info_t* info_ptr = nullptr;
     snd_ctl_card_info_t* card_info_ptr = nullptr;
+    snd_ctl_event_t* event_ptr = nullptr;
+    bool events_enabled = false;
+    int event_poll_fd = -1;  // the control handle's poll descriptor, once subscribed
+    bool events_failed = false;  // snd_ctl_read() failed with something other than "no events"
 
     std::map<std::string, int> ctl_iface_cache;
     std::map<std::pair<std::string, unsigned int>, ControlInfo> ctl_info_cache;
 
+    // Shadow register cache. Writable multi-element controls (matrix rows, output volumes) keep
+    // a copy of their last known contents, so a partial or single-element write can be sent
+    // without reading the row first. A shadow is filled by any hardware read, updated by our own
+    // successful writes, re-read on value events and dropped when a write fails or the element
+    // is removed; until it is valid again writes fall back to read-modify-write. Shadows are
+    // only trusted while control events are subscribed: in the polling fallback every partial
+    // write reads the row first, as other clients may have changed it since the last poll.
+    struct ShadowRow {
+        ControlHandle ctl;
+        bool valid = false;
+        bool refresh = false; // a value event arrived during the current read_events() drain
+        std::vector<long> values;
+    };
+    std::vector<ShadowRow> shadows;
+    std::vector<int> shadow_by_numid; // numid -> slot, -1 if not shadowed
+
     int _find_iface(const std::string& name);
+    bool _read_handle(const ControlHandle& h);
+    bool _load_row(const ControlHandle& h);
+    ShadowRow* _shadow(const ControlHandle& h);
+    ShadowRow* _current_shadow(const ControlHandle& h);
+    void _capture_shadow(const ControlHandle& h);
+    void _drop_shadow(const ControlHandle& h);
     static int find_fireface_card();
     
     void allocate_resources();
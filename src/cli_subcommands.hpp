@@ -11,4 +11,10 @@ int RunDaemon(int argc, char** argv);
 // `totalmixer info [--card N]` - dump the card's ALSA controls for diagnostics.
 int RunInfo(int argc, char** argv);
 
+// `totalmixer bench [...]` - engine benchmarks against the simulated card (no hardware needed).
+int RunBench(int argc, char** argv);
+
+// `totalmixer overloads [...]` - list or clear the persistent overload log.
+int RunOverloads(int argc, char** argv);
+
 } // namespace TotalMixer
@@ -1,5 +1,5 @@
 #include "config_manager.hpp"
-#include "mixer_types.hpp"  // for MeterPreferences, OscPreferences (GUI-free)
+#include "mixer_types.hpp"  // for MeterPreferences, OscPreferences, DisplayPreferences (GUI-free)
 #include <fstream>
 #include <sstream>
 #include <filesystem>
@@ -95,7 +95,7 @@ std::string ConfigManager::GetConfigPath() {
     return base + "/totalmix/preferences.json";
 }
 
-static bool load_impl(MeterPreferences& prefs, OscPreferences& osc) {
+static bool load_impl(MeterPreferences& prefs, OscPreferences& osc, DisplayPreferences& display) {
     std::string path = ConfigManager::GetConfigPath();
     std::ifstream f(path);
     if (!f.is_open()) return false;
@@ -127,6 +127,12 @@ static bool load_impl(MeterPreferences& prefs, OscPreferences& osc) {
 
         v = json_get_value(meters_body, "rms_tau_seconds");
         if (!v.empty()) prefs.rms_tau_seconds = std::stof(v);
+
+        v = json_get_value(meters_body, "sample_hz");
+        if (!v.empty()) prefs.sample_hz = std::stoi(v);
+
+        v = json_get_value(meters_body, "history_seconds");
+        if (!v.empty()) prefs.history_seconds = std::stoi(v);
     }
 
     // Get "osc" object (optional; absent in pre-OSC config files)
@@ -142,10 +148,21 @@ static bool load_impl(MeterPreferences& prefs, OscPreferences& osc) {
         if (!v.empty()) osc.out_port = std::stoi(v);
     }
 
+    // Get "display" object (optional; absent in older config files)
+    std::string display_body = json_get_object(root_body, "display");
+    if (!display_body.empty()) {
+        v = json_get_value(display_body, "active_fps");
+        if (!v.empty()) display.active_fps = std::stoi(v);
+
+        v = json_get_value(display_body, "idle_fps");
+        if (!v.empty()) display.idle_fps = std::stoi(v);
+    }
+
     return true;
 }
 
-static bool save_impl(const MeterPreferences& prefs, const OscPreferences& osc) {
+static bool save_impl(const MeterPreferences& prefs, const OscPreferences& osc,
+                      const DisplayPreferences& display) {
     std::string path = ConfigManager::GetConfigPath();
     std::filesystem::create_directories(std::filesystem::path(path).parent_path());
 
@@ -157,23 +174,30 @@ static bool save_impl(const MeterPreferences& prefs, const OscPreferences& osc)
     f << "    \"ovr_sample_count\": " << prefs.ovr_sample_count << ",\n";
     f << "    \"peak_hold_seconds\": " << prefs.peak_hold_seconds << ",\n";
     f << "    \"rms_plus_3db\": " << (prefs.rms_plus_3db ? "true" : "false") << ",\n";
-    f << "    \"rms_tau_seconds\": " << prefs.rms_tau_seconds << "\n";
+    f << "    \"rms_tau_seconds\": " << prefs.rms_tau_seconds << ",\n";
+    f << "    \"sample_hz\": " << prefs.sample_hz << ",\n";
+    f << "    \"history_seconds\": " << prefs.history_seconds << "\n";
     f << "  },\n";
     f << "  \"osc\": {\n";
     f << "    \"enabled\": " << (osc.enabled ? "true" : "false") << ",\n";
     f << "    \"in_port\": " << osc.in_port << ",\n";
     f << "    \"out_port\": " << osc.out_port << "\n";
+    f << "  },\n";
+    f << "  \"display\": {\n";
+    f << "    \"active_fps\": " << display.active_fps << ",\n";
+    f << "    \"idle_fps\": " << display.idle_fps << "\n";
     f << "  }\n";
     f << "}\n";
     return true;
 }
 
-bool ConfigManager::Load(MeterPreferences& meters, OscPreferences& osc) {
-    return load_impl(meters, osc);
+bool ConfigManager::Load(MeterPreferences& meters, OscPreferences& osc, DisplayPreferences& display) {
+    return load_impl(meters, osc, display);
 }
 
-bool ConfigManager::Save(const MeterPreferences& meters, const OscPreferences& osc) {
-    return save_impl(meters, osc);
+bool ConfigManager::Save(const MeterPreferences& meters, const OscPreferences& osc,
+                         const DisplayPreferences& display) {
+    return save_impl(meters, osc, display);
 }
 
 } // namespace TotalMixer
@@ -1,33 +1,52 @@
 // `totalmixer daemon` subcommand: headless OSC control daemon for the RME Fireface mixer.
 //
-// This is a thin frontend over MixerEngine with no GUI, no meters, and no display
-// dependency (links neither ImGui, GLFW, nor OpenGL). Its sole purpose is to expose the
-// mixer over OSC, so it forces the OSC endpoint on regardless of the persisted preference.
+// This is a thin frontend over MixerEngine with no GUI and no display dependency (links
+// neither ImGui, GLFW, nor OpenGL). Its sole purpose is to expose the mixer (and, on request,
+// its meters) over OSC, so it forces the OSC endpoint on regardless of the persisted preference.
 //
-// Lifecycle: parse args -> Init() (service + ALSA) -> start OSC -> timed Tick() loop until
-// SIGINT/SIGTERM -> graceful StopOsc(). Any startup failure exits non-zero so a systemd
-// unit with Restart=on-failure can own the retry policy (no internal retry loop).
+// Lifecycle: parse args -> Init() (service + ALSA) -> start OSC -> epoll-driven Tick() loop
+// until SIGINT/SIGTERM -> graceful StopOsc(). Any startup failure, and losing the card while
+// running, exits non-zero so a systemd unit with Restart=on-failure can own the retry policy
+// (no internal retry loop).
 
-#include <atomic>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <cerrno>
 #include <chrono>
 #include <csignal>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
 #include <string>
-#include <thread>
 
 #include "cli_subcommands.hpp"
+#include "fake_fireface.hpp"
 #include "mixer_engine.hpp"
 
 namespace {
 
-// Set from the signal handler only; the main loop polls it. sig_atomic_t keeps the write
-// async-signal-safe, and volatile prevents the loop from caching it in a register.
-volatile std::sig_atomic_t g_running = 1;
+// Arm the one-shot loop timer for delay_ms from now (clamped to at least 1ms, so a deadline
+// that is already due still yields one epoll pass), or disarm it for delay_ms < 0.
+void ArmTimer(int timer_fd, long delay_ms) {
+    itimerspec spec{};
+    if (delay_ms >= 0) {
+        if (delay_ms < 1) delay_ms = 1;
+        spec.it_value.tv_sec = delay_ms / 1000;
+        spec.it_value.tv_nsec = (delay_ms % 1000) * 1000000L;
+    }
+    timerfd_settime(timer_fd, 0, &spec, nullptr);
+}
 
-void HandleSignal(int) {
-    g_running = 0;
+bool AddToEpoll(int epoll_fd, int fd) {
+    if (fd < 0) return true;
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    return epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) == 0;
 }
 
 void PrintUsage() {
@@ -41,6 +60,10 @@ void PrintUsage() {
         "  --osc-in <port>    UDP port to listen on for control messages (default: preferences.json)\n"
         "  --osc-out <port>   UDP port to send state feedback to on the client host (default: preferences.json)\n"
         "  --card <index>     ALSA card index to bind (default: auto-select first Fireface)\n"
+        "  --simulate         Run on a simulated Fireface 400 instead of the hardware\n"
+        "  --sim-latency-us <us>  Simulated cost of each ALSA read/write with --simulate (default: 0)\n"
+        "  --write-rate <hz>  Most ALSA write flushes per second; edits in between are coalesced\n"
+        "                     (default: 100, 0 = write every edit immediately)\n"
         "  -h, --help         Show this help and exit\n"
         "\n"
         "Note: the OSC endpoint is unauthenticated UDP; run only on a trusted LAN.\n";
@@ -73,6 +96,9 @@ int RunDaemon(int argc, char** argv) {
     int card_index = -1;       // -1 = auto-select first Fireface
     int osc_in_override = -1;   // -1 = keep preferences.json value
     int osc_out_override = -1;
+    bool simulate = false;
+    int sim_latency_us = 0;
+    int write_rate = -1;        // -1 = engine default
 
     for (int i = 1; i < argc; ++i) {
         const char* arg = argv[i];
@@ -85,6 +111,16 @@ int RunDaemon(int argc, char** argv) {
             if (!ParseIntArg(argc, argv, i, "--osc-out", osc_out_override)) return 2;
         } else if (std::strcmp(arg, "--card") == 0) {
             if (!ParseIntArg(argc, argv, i, "--card", card_index)) return 2;
+        } else if (std::strcmp(arg, "--simulate") == 0) {
+            simulate = true;
+        } else if (std::strcmp(arg, "--sim-latency-us") == 0) {
+            if (!ParseIntArg(argc, argv, i, "--sim-latency-us", sim_latency_us)) return 2;
+        } else if (std::strcmp(arg, "--write-rate") == 0) {
+            if (!ParseIntArg(argc, argv, i, "--write-rate", write_rate)) return 2;
+            if (write_rate < 0) {
+                std::cerr << "Error: --write-rate must not be negative\n";
+                return 2;
+            }
         } else {
             std::cerr << "Error: unknown argument '" << arg << "'\n";
             PrintUsage();
@@ -92,7 +128,18 @@ int RunDaemon(int argc, char** argv) {
         }
     }
 
+    // SIGINT/SIGTERM are taken through a signalfd in the loop below, so they are blocked here,
+    // before Init() starts any thread: every thread inherits the mask and none of them can
+    // take the default (fatal) disposition instead. A signal during startup stays pending and
+    // shuts the daemon down as soon as the loop begins.
+    sigset_t stop_signals;
+    sigemptyset(&stop_signals);
+    sigaddset(&stop_signals, SIGINT);
+    sigaddset(&stop_signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stop_signals, nullptr);
+
     MixerEngine engine;
+    if (write_rate >= 0) engine.SetWriteRate(write_rate);
 
     // Daemon mode exists to serve OSC, so force it on and apply any port overrides before Init.
     OscPreferences& osc = engine.oscPrefs();
@@ -101,7 +148,14 @@ int RunDaemon(int argc, char** argv) {
     if (osc_out_override >= 0) osc.out_port = osc_out_override;
 
     // Connect to the kernel service and the card. Any failure is fatal (systemd owns retries).
-    MixerEngine::InitResult init = engine.Init(card_index);
+    MixerEngine::InitResult init;
+    if (simulate) {
+        FakeFireface::Latency lat;
+        lat.read = lat.write = std::chrono::microseconds(sim_latency_us);
+        init = engine.Init(std::make_unique<FakeFireface>(lat));
+    } else {
+        init = engine.Init(card_index);
+    }
     if (!init.connected) {
         std::cerr << "Daemon: failed to connect to the Fireface (service or hardware "
                      "unavailable). Exiting." << std::endl;
@@ -116,25 +170,73 @@ int RunDaemon(int argc, char** argv) {
         return 1;
     }
 
-    // Install signal handlers only after we are fully up, so a signal during startup uses the
-    // default disposition rather than flipping g_running before the loop begins.
-    std::signal(SIGINT, HandleSignal);
-    std::signal(SIGTERM, HandleSignal);
+    // Everything the loop waits on. The OSC wakeup fd turns readable when a command is queued
+    // or a client needs feedback, the card's event fd when a control changes, the timer when
+    // the engine's next timed job (poll, feedback push) is due.
+    int signal_fd = signalfd(-1, &stop_signals, SFD_NONBLOCK | SFD_CLOEXEC);
+    int timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    const int card_fd = engine.hardwareEventFd();
+    if (signal_fd < 0 || timer_fd < 0 || epoll_fd < 0 ||
+        !AddToEpoll(epoll_fd, signal_fd) || !AddToEpoll(epoll_fd, timer_fd) ||
+        !AddToEpoll(epoll_fd, engine.oscWakeupFd()) || !AddToEpoll(epoll_fd, card_fd)) {
+        std::cerr << "Daemon: failed to set up the event loop: " << std::strerror(errno)
+                  << ". Exiting." << std::endl;
+        engine.StopOsc();
+        return 1;
+    }
 
     std::cout << "Daemon: ready. OSC listening on port " << osc.in_port
               << ", feedback to port " << osc.out_port << ". Press Ctrl+C to stop." << std::endl;
 
-    // Timed service loop. There is no frame clock here, so Tick's internal throttles (500ms
-    // poll, 50ms feedback) are driven by an explicit ~5ms sleep. inputs_busy is always false
-    // (no widgets to drag). Meters are never polled (no display consumer).
-    while (g_running) {
+    // Event loop. Tick() does all the work (OSC drain, control event drain, polls, feedback;
+    // meters stream from their own sampler thread); between ticks the daemon sleeps in epoll
+    // until input arrives or the engine's next deadline. With no clients and a quiet card that
+    // is one wakeup per scrubber poll. inputs_busy is always false (no widgets to drag).
+    bool running = true;
+    int exit_code = 0;
+    while (running) {
         engine.Tick(false);
-        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        // An unplugged card never comes back on this connection (and its descriptor would poll
+        // as an error on every pass): exit and let the service manager reconnect.
+        if (engine.hardwareLost()) {
+            std::cerr << "Daemon: lost the Fireface. Exiting." << std::endl;
+            exit_code = 1;
+            break;
+        }
+        ArmTimer(timer_fd, engine.NextTickDelayMs());
+
+        epoll_event events[4];
+        int n = epoll_wait(epoll_fd, events, 4, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "Daemon: epoll_wait failed: " << std::strerror(errno) << std::endl;
+            exit_code = 1;
+            break;
+        }
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == signal_fd) {
+                signalfd_siginfo info;
+                while (read(signal_fd, &info, sizeof(info)) == sizeof(info)) running = false;
+            } else if (fd == timer_fd) {
+                uint64_t expirations;
+                (void)!read(timer_fd, &expirations, sizeof(expirations));
+            } else if (fd == card_fd && (events[i].events & (EPOLLERR | EPOLLHUP))) {
+                epoll_ctl(epoll_fd, EPOLL_CTL_DEL, card_fd, nullptr);
+                engine.MarkHardwareLost();
+            }
+            // The OSC wakeup and card event fds are drained by Tick() itself.
+        }
     }
 
     std::cout << "\nDaemon: shutting down." << std::endl;
     engine.StopOsc();
-    return 0;
+    engine.FlushWrites();
+    close(epoll_fd);
+    close(timer_fd);
+    close(signal_fd);
+    return exit_code;
 }
 
 } // namespace TotalMixer
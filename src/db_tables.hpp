@@ -0,0 +1,282 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace TotalMixer {
+
+// dB conversion tables, generated at compile time. Every conversion the mixer does between ALSA
+// gain values, hardware knob positions, dB and their text is a table lookup or a couple of
+// integer operations: nothing here allocates, calls libm or builds a string at run time, so the
+// GUI can label every matrix cell per frame and parse typed dB values without a scan.
+//
+// RME Fireface 400 volume mapping (from Linux kernel ff-protocol-former.c)
+// Two-step conversion: ALSA raw value (0-65536) → Hardware Knob (0-63) → dB
+//
+// Step 1: amp = (63 * (65536 - val)) / 65536
+// Step 2: Lookup amp in HARDWARE_DB_TABLE
+//
+// CRITICAL: Must use exact formula from Rust implementation to avoid integer division errors.
+// Mathematical simplification amp = 63 - (val * 63 / 65536) produces OFF-BY-ONE errors!
+//
+// Note: Hardware skips -55 dB and -57 dB (hardcoded in RME hardware)
+// Reference: Linux kernel sound/firewire/fireface/ff-protocol-former.c lines 618-633
+//            snd-firewire-ctl-services ff400.rs lines 288-299
+
+constexpr int kGainRawMax = 65536;
+constexpr int kKnobCount = 64;
+constexpr int kMuteKnob = 63;
+
+constexpr float HARDWARE_DB_TABLE[kKnobCount] = {
+    6.0f,   // knob 0
+    5.0f,   // knob 1
+    4.0f,   // knob 2
+    3.0f,   // knob 3
+    2.0f,   // knob 4
+    1.0f,   // knob 5
+    0.0f,   // knob 6
+    -1.0f,  // knob 7
+    -2.0f,  // knob 8
+    -3.0f,  // knob 9
+    -4.0f,  // knob 10
+    -5.0f,  // knob 11
+    -6.0f,  // knob 12
+    -7.0f,  // knob 13
+    -8.0f,  // knob 14
+    -9.0f,  // knob 15
+    -10.0f, // knob 16
+    -11.0f, // knob 17
+    -12.0f, // knob 18
+    -13.0f, // knob 19
+    -14.0f, // knob 20
+    -15.0f, // knob 21
+    -16.0f, // knob 22
+    -17.0f, // knob 23
+    -18.0f, // knob 24
+    -19.0f, // knob 25
+    -20.0f, // knob 26
+    -21.0f, // knob 27
+    -22.0f, // knob 28
+    -23.0f, // knob 29
+    -24.0f, // knob 30
+    -25.0f, // knob 31
+    -26.0f, // knob 32
+    -27.0f, // knob 33
+    -28.0f, // knob 34
+    -29.0f, // knob 35
+    -30.0f, // knob 36
+    -31.0f, // knob 37
+    -32.0f, // knob 38
+    -33.0f, // knob 39
+    -34.0f, // knob 40
+    -35.0f, // knob 41
+    -36.0f, // knob 42
+    -37.0f, // knob 43
+    -38.0f, // knob 44
+    -39.0f, // knob 45
+    -40.0f, // knob 46
+    -41.0f, // knob 47
+    -42.0f, // knob 48
+    -43.0f, // knob 49
+    -44.0f, // knob 50
+    -45.0f, // knob 51
+    -46.0f, // knob 52
+    -47.0f, // knob 53
+    -48.0f, // knob 54
+    -49.0f, // knob 55
+    -50.0f, // knob 56
+    -51.0f, // knob 57
+    -52.0f, // knob 58
+    -53.0f, // knob 59
+    -54.0f, // knob 60
+    -56.0f, // knob 61 (⚠️ SKIPS -55)
+    -58.0f, // knob 62 (⚠️ SKIPS -57)
+    -100.0f // knob 63 (mute/-inf)
+};
+
+// ── Raw ↔ knob ──
+// ALSA raw value → knob position (0 = +6 dB, 63 = mute). The exact integer formula above; a
+// 65537-entry table would only be slower.
+constexpr int raw_to_knob(long val) {
+    if (val <= 0) return kMuteKnob;
+    if (val > kGainRawMax) val = kGainRawMax;
+    long amp = (63 * (kGainRawMax - val)) / kGainRawMax;
+    return amp < 0 ? 0 : (amp > kMuteKnob ? kMuteKnob : static_cast<int>(amp));
+}
+
+namespace detail {
+
+constexpr std::array<int, kKnobCount> MakeKnobRawTable() {
+    std::array<int, kKnobCount> t{};
+    // Rust formula: vol = (65536 * (63 - amp)) / 63
+    for (int amp = 0; amp < kKnobCount; ++amp) t[amp] = (kGainRawMax * (63 - amp)) / 63;
+    return t;
+}
+
+} // namespace detail
+
+// Knob position → the ALSA raw value the hardware writes for it.
+constexpr std::array<int, kKnobCount> KNOB_RAW_TABLE = detail::MakeKnobRawTable();
+
+static_assert(raw_to_knob(KNOB_RAW_TABLE[0]) == 0 && raw_to_knob(KNOB_RAW_TABLE[kMuteKnob]) == kMuteKnob,
+              "KNOB_RAW_TABLE must round-trip through raw_to_knob");
+
+// ── Knob → dB text ──
+// Every knob's label, "+6.00" .. "-58.00", and "-inf" for mute (the same text the GUI always
+// showed). All table entries are whole dB, which the generator relies on.
+struct DbLabel {
+    char text[8];
+};
+
+namespace detail {
+
+constexpr bool AllWholeDb() {
+    for (int amp = 0; amp < kKnobCount; ++amp) {
+        if (HARDWARE_DB_TABLE[amp] != static_cast<float>(static_cast<int>(HARDWARE_DB_TABLE[amp]))) return false;
+    }
+    return true;
+}
+
+// "+d.00" / "-dd.00" for a whole dB value; "-inf" at or below -65 dB.
+constexpr DbLabel MakeDbLabel(int db) {
+    DbLabel l{};
+    if (db <= -65) {
+        l.text[0] = '-'; l.text[1] = 'i'; l.text[2] = 'n'; l.text[3] = 'f';
+        return l;
+    }
+    int n = 0;
+    l.text[n++] = db < 0 ? '-' : '+';
+    int mag = db < 0 ? -db : db;
+    if (mag >= 10) l.text[n++] = static_cast<char>('0' + mag / 10);
+    l.text[n++] = static_cast<char>('0' + mag % 10);
+    l.text[n++] = '.';
+    l.text[n++] = '0';
+    l.text[n++] = '0';
+    return l;
+}
+
+constexpr std::array<DbLabel, kKnobCount> MakeKnobLabelTable() {
+    std::array<DbLabel, kKnobCount> t{};
+    for (int amp = 0; amp < kKnobCount; ++amp) t[amp] = MakeDbLabel(static_cast<int>(HARDWARE_DB_TABLE[amp]));
+    return t;
+}
+
+} // namespace detail
+
+static_assert(detail::AllWholeDb(), "knob labels are generated for whole-dB table entries only");
+
+constexpr std::array<DbLabel, kKnobCount> KNOB_LABEL_TABLE = detail::MakeKnobLabelTable();
+
+// ── dB → knob ──
+// Nearest knob for every dB value in 0.01 dB steps over the knob range (+6 .. -58 dB), ties
+// going to the louder knob. Values typed with up to two decimals (the display precision) map
+// exactly as a scan of HARDWARE_DB_TABLE would.
+constexpr int kDbCentiMax = 600;
+constexpr int kDbCentiMin = -5800;
+
+namespace detail {
+
+constexpr std::array<uint8_t, kDbCentiMax - kDbCentiMin + 1> MakeDbKnobTable() {
+    std::array<uint8_t, kDbCentiMax - kDbCentiMin + 1> t{};
+    // The knob dB values only fall with the knob, so the nearest knob only moves forward as
+    // the target falls: one sweep, advancing while the next knob is strictly closer.
+    int amp = 0;
+    for (int cdb = kDbCentiMax; cdb >= kDbCentiMin; --cdb) {
+        auto dist = [cdb](int a) {
+            int d = static_cast<int>(HARDWARE_DB_TABLE[a]) * 100 - cdb;
+            return d < 0 ? -d : d;
+        };
+        while (amp + 1 < kMuteKnob && dist(amp + 1) < dist(amp)) ++amp;
+        t[cdb - kDbCentiMin] = static_cast<uint8_t>(amp);
+    }
+    return t;
+}
+
+} // namespace detail
+
+constexpr std::array<uint8_t, kDbCentiMax - kDbCentiMin + 1> DB_CENTI_KNOB_TABLE = detail::MakeDbKnobTable();
+
+// dB → ALSA raw value. Above +6 dB clamps to +6; below -58 dB (and NaN) is mute.
+inline int db_to_val(float db) {
+    if (!(db >= -58.0f)) return 0;
+    if (db > 6.0f) db = 6.0f;
+    long cdb = std::lround(db * 100.0f);
+    if (cdb < kDbCentiMin) cdb = kDbCentiMin;
+    return KNOB_RAW_TABLE[DB_CENTI_KNOB_TABLE[cdb - kDbCentiMin]];
+}
+
+// ── Meter scale ──
+// Meter display scale: linear amplitude is mapped onto a -kMeterFloorDb .. 0 dBFS bar
+// (RME TotalMix-style wide range so low-level inputs like mics remain visible). Display levels
+// (MeterLevel) are positions on that bar in [0, 1].
+constexpr float kMeterFloorDb = 90.0f;
+constexpr int kMeterFloorDbInt = 90;
+
+constexpr float meter_db_to_display(float db) {
+    float d = (db + kMeterFloorDb) / kMeterFloorDb;
+    return d < 0.0f ? 0.0f : (d > 1.0f ? 1.0f : d);
+}
+
+namespace detail {
+
+// "-90" .. "+0" in whole dB, index = dB below full scale.
+constexpr std::array<DbLabel, kMeterFloorDbInt + 1> MakeMeterLabelTable() {
+    std::array<DbLabel, kMeterFloorDbInt + 1> t{};
+    for (int below = 0; below <= kMeterFloorDbInt; ++below) {
+        DbLabel l{};
+        int n = 0;
+        l.text[n++] = below == 0 ? '+' : '-';
+        if (below >= 10) l.text[n++] = static_cast<char>('0' + below / 10);
+        l.text[n++] = static_cast<char>('0' + below % 10);
+        t[below] = l;
+    }
+    return t;
+}
+
+} // namespace detail
+
+constexpr std::array<DbLabel, kMeterFloorDbInt + 1> METER_LABEL_TABLE = detail::MakeMeterLabelTable();
+
+// Meter display level → whole-dBFS text ("-inf" at the floor).
+inline const char* meter_display_to_db_cstr(float display) {
+    if (!(display > 0.0f)) return "-inf";
+    int below = static_cast<int>(std::lround((1.0f - display) * kMeterFloorDb));
+    if (below < 0) below = 0;
+    if (below > kMeterFloorDbInt) below = kMeterFloorDbInt;
+    return METER_LABEL_TABLE[below].text;
+}
+
+// ── Text ──
+// ALSA raw value → dB text, e.g. "-12.00" (a pointer into KNOB_LABEL_TABLE; never freed).
+inline const char* val_to_db_cstr(long val) {
+    return KNOB_LABEL_TABLE[raw_to_knob(val)].text;
+}
+
+// The same text written into a caller buffer (always terminated, truncated if it does not fit);
+// show_plus = false drops the leading '+' (for an edit box). Returns the length written.
+inline size_t val_to_db_buf(long val, char* buf, size_t size, bool show_plus = true) {
+    if (size == 0) return 0;
+    const char* text = val_to_db_cstr(val);
+    if (!show_plus && text[0] == '+') ++text;
+    size_t len = std::strlen(text);
+    if (len >= size) len = size - 1;
+    std::memcpy(buf, text, len);
+    buf[len] = '\0';
+    return len;
+}
+
+// Typed dB text → ALSA raw value. Accepts what strtof does (so "+3", "-12.5", " -6dB", "-inf");
+// anything that is not a number is mute, as is everything at or below -58.
+inline int db_cstr_to_val(const char* text) {
+    if (!text) return 0;
+    char* end = nullptr;
+    float db = std::strtof(text, &end);
+    if (end == text) return 0;
+    return db_to_val(db);
+}
+
+} // namespace TotalMixer
@@ -0,0 +1,267 @@
+#include "fake_fireface.hpp"
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace TotalMixer {
+
+static constexpr long kGainMax = 65536;
+static constexpr long kMeterMax = 0x7fffffff;
+
+FakeFireface::FakeFireface() : FakeFireface(Latency{}) {}
+
+FakeFireface::FakeFireface(Latency latency)
+    : lat(latency), started(std::chrono::steady_clock::now()) {
+    wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    // ── Mixer ──
+    add("output-volume", 0, ControlType::Int, 18, 0, kGainMax);
+    for (unsigned int i = 0; i < 8; ++i)  add("mixer:analog-source-gain", i, ControlType::Int, 18, 0, kGainMax);
+    for (unsigned int i = 0; i < 2; ++i)  add("mixer:spdif-source-gain", i, ControlType::Int, 18, 0, kGainMax);
+    for (unsigned int i = 0; i < 8; ++i)  add("mixer:adat-source-gain", i, ControlType::Int, 18, 0, kGainMax);
+    for (unsigned int i = 0; i < 18; ++i) add("mixer:stream-source-gain", i, ControlType::Int, 18, 0, kGainMax);
+
+    // ── Meters ──
+    add("metering", 0, ControlType::Bool, 1, 0, 1);
+    add("meter:analog-output", 0, ControlType::Int, 8, 0, kMeterMax, false);
+    add("meter:spdif-output", 0, ControlType::Int, 2, 0, kMeterMax, false);
+    add("meter:adat-output", 0, ControlType::Int, 8, 0, kMeterMax, false);
+    add("meter:analog-input", 0, ControlType::Int, 8, 0, kMeterMax, false);
+    add("meter:spdif-input", 0, ControlType::Int, 2, 0, kMeterMax, false);
+    add("meter:adat-input", 0, ControlType::Int, 8, 0, kMeterMax, false);
+    add("meter:stream-input", 0, ControlType::Int, 18, 0, kMeterMax, false);
+
+    // ── Options (Control tab). Item lists follow the service's naming closely enough for the UI. ──
+    const std::vector<std::string> clock_items = {"Internal", "Word-clock", "S/PDIF", "ADAT"};
+    const std::vector<std::string> level_items = {"High-gain", "+4dBu", "-10dBV"};
+    add("primary-clock-source", 0, ControlType::Enum, 1, 0, 0, true, clock_items);
+    add("word-clock-single-speed", 0, ControlType::Bool, 1, 0, 1);
+    add("active-clock-source", 0, ControlType::Enum, 1, 0, 0, false, clock_items);
+    add("line-input-level", 0, ControlType::Enum, 1, 0, 0, true, {"Low-gain", "+4dBu", "-10dBV"});
+    add("line-3/4-inst", 0, ControlType::Bool, 1, 0, 1);
+    add("line-3/4-pad", 0, ControlType::Bool, 1, 0, 1);
+    add("mic-1/2-powering", 0, ControlType::Bool, 1, 0, 1);
+    add("line-output-level", 0, ControlType::Enum, 1, 0, 0, true, level_items);
+    add("headphone-output-level", 0, ControlType::Enum, 1, 0, 0, true, level_items);
+    add("optical-output-signal", 0, ControlType::Enum, 1, 0, 0, true, {"ADAT", "S/PDIF"});
+    add("spdif-input-interface", 0, ControlType::Enum, 1, 0, 0, true, {"Coaxial", "Optical"});
+    add("spdif-output-format", 0, ControlType::Enum, 1, 0, 0, true, {"Consumer", "Professional"});
+    add("spdif-output-non-audio", 0, ControlType::Bool, 1, 0, 1);
+}
+
+void FakeFireface::add(const std::string& name, unsigned int index, ControlType type, unsigned int count,
+                       long min, long max, bool writable, std::vector<std::string> items) {
+    Control c;
+    c.name = name;
+    c.index = index;
+    c.info.kind = type;
+    switch (type) {
+        case ControlType::Bool:  c.info.type = "Bool"; break;
+        case ControlType::Int:   c.info.type = "Int"; break;
+        case ControlType::Enum:  c.info.type = "Enum"; break;
+        case ControlType::Other: c.info.type = "Other"; break;
+    }
+    c.info.min = min;
+    c.info.max = max;
+    c.info.count = count;
+    c.info.numid = static_cast<unsigned int>(controls.size() + 1);
+    c.info.iface = SND_CTL_ELEM_IFACE_MIXER;
+    c.info.writable = writable;
+    c.info.enum_items = std::move(items);
+    c.values.assign(count, 0);
+    c.meter = name.compare(0, 6, "meter:") == 0;
+    controls.push_back(std::move(c));
+}
+
+FakeFireface::Control* FakeFireface::find(const std::string& name, unsigned int index) {
+    for (auto& c : controls) {
+        if (c.index == index && c.name == name) return &c;
+    }
+    return nullptr;
+}
+
+FakeFireface::Control* FakeFireface::at(const ControlHandle& h) {
+    if (h.numid == 0 || h.numid > controls.size()) return nullptr;
+    return &controls[h.numid - 1];
+}
+
+void FakeFireface::delay(std::chrono::microseconds d) {
+    if (d.count() <= 0) return;
+    if (d >= std::chrono::milliseconds(2)) {
+        std::this_thread::sleep_for(d);
+        return;
+    }
+    auto until = std::chrono::steady_clock::now() + d;
+    while (std::chrono::steady_clock::now() < until) {}
+}
+
+FakeFireface::~FakeFireface() {
+    if (wake_fd >= 0) ::close(wake_fd);
+}
+
+void FakeFireface::queue_value_event(const Control& c) {
+    if (!events_enabled) return;
+    ControlEvent ev;
+    ev.numid = c.info.numid;
+    ev.index = c.index;
+    ev.mask = SND_CTL_EVENT_MASK_VALUE;
+    if (pending_events.empty() && wake_fd >= 0) {
+        uint64_t one = 1;
+        (void)!::write(wake_fd, &one, sizeof(one));
+    }
+    pending_events.push_back(ev);
+    counters.events++;
+}
+
+// Slow per-channel sweep over roughly -70..0 dBFS, with every eighth channel peaking into the
+// overload zone, so the meter ballistics, peak hold and OVR all get exercised.
+void FakeFireface::fill_meter(Control& c) {
+    Control* metering = find("metering", 0);
+    if (!metering || metering->values[0] == 0) return; // meters freeze when metering is off
+
+    double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    for (unsigned int i = 0; i < c.values.size(); ++i) {
+        double phase = 0.37 * c.info.numid + 0.91 * i;
+        double sweep = 0.5 + 0.5 * std::sin(2.0 * M_PI * (0.15 + 0.05 * i) * t + phase);
+        double top_db = (i % 8 == 0) ? 0.0 : -6.0;
+        double db = -70.0 + (70.0 + top_db) * sweep;
+        c.values[i] = static_cast<long>(std::pow(10.0, db / 20.0) * kMeterMax);
+    }
+}
+
+std::string FakeFireface::get_card_name() {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+    return "RME Fireface 400 (simulated), GUID 0000000000000000 at sim0, S400";
+}
+
+std::optional<ControlInfo> FakeFireface::get_control_info(const std::string& name, unsigned int index) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+    counters.infos++;
+    delay(lat.info);
+    Control* c = find(name, index);
+    if (!c) return std::nullopt;
+    return c->info;
+}
+
+std::optional<ControlHandle> FakeFireface::resolve(const std::string& name, unsigned int index) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+    auto info = get_control_info(name, index);
+    if (!info) return std::nullopt;
+
+    ControlHandle h;
+    h.numid = info->numid;
+    h.iface = info->iface;
+    h.type = info->kind;
+    h.count = info->count;
+    h.min = info->min;
+    h.max = info->max;
+    return h;
+}
+
+int FakeFireface::read(const ControlHandle& h, long* out, unsigned int max_count) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+    counters.reads++;
+    delay(lat.read);
+    Control* c = at(h);
+    if (!c) return -1;
+    if (c->meter) fill_meter(*c);
+
+    unsigned int n = h.count < max_count ? h.count : max_count;
+    if (n > c->values.size()) n = static_cast<unsigned int>(c->values.size());
+    for (unsigned int i = 0; i < n; ++i) out[i] = c->values[i];
+    return static_cast<int>(n);
+}
+
+bool FakeFireface::write(const ControlHandle& h, const long* values, unsigned int count) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+    counters.writes++;
+    delay(lat.write);
+    Control* c = at(h);
+    if (!c || !c->info.writable) return false;
+    if (count > c->values.size()) count = static_cast<unsigned int>(c->values.size());
+
+    bool changed = false;
+    for (unsigned int i = 0; i < count; ++i) {
+        changed |= (c->values[i] != values[i]);
+        c->values[i] = values[i];
+    }
+    if (changed) queue_value_event(*c); // the kernel only notifies on an actual change
+    return true;
+}
+
+bool FakeFireface::write_element(const ControlHandle& h, unsigned int element, long value) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+    if (element >= h.count) return false;
+    counters.writes++;
+    delay(lat.write);
+    Control* c = at(h);
+    if (!c || !c->info.writable || element >= c->values.size()) return false;
+    if (c->values[element] == value) return true;
+    c->values[element] = value;
+    queue_value_event(*c);
+    return true;
+}
+
+bool FakeFireface::commit(MatrixTransaction& txn) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+    bool ok = true;
+    const auto& edits = txn.pending();
+    for (size_t i = 0; i < edits.size(); ++i) {
+        const ControlHandle& row = edits[i].row;
+
+        // Same row grouping as AlsaCore::commit: one write per touched row.
+        bool done = false;
+        for (size_t j = 0; j < i && !done; ++j) done = (edits[j].row.numid == row.numid);
+        if (done) continue;
+
+        counters.writes++;
+        delay(lat.write);
+        Control* c = at(row);
+        if (!c || !c->info.writable) {
+            ok = false;
+            continue;
+        }
+        bool changed = false;
+        for (size_t k = i; k < edits.size(); ++k) {
+            const auto& e = edits[k];
+            if (e.row.numid != row.numid || e.element >= c->values.size()) continue;
+            changed |= (c->values[e.element] != e.value);
+            c->values[e.element] = e.value;
+        }
+        if (changed) queue_value_event(*c);
+    }
+    txn.clear();
+    return ok;
+}
+
+bool FakeFireface::external_write(const std::string& name, unsigned int index, unsigned int element, long value) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+    Control* c = find(name, index);
+    if (!c || element >= c->values.size()) return false;
+    if (c->values[element] == value) return true;
+    c->values[element] = value;
+    queue_value_event(*c);
+    return true;
+}
+
+bool FakeFireface::subscribe_events() {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+    events_enabled = true;
+    return true;
+}
+
+size_t FakeFireface::read_events(std::vector<ControlEvent>& out) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+    out.clear();
+    if (!events_enabled) return 0;
+    if (!pending_events.empty() && wake_fd >= 0) {
+        uint64_t count;
+        (void)!::read(wake_fd, &count, sizeof(count));
+    }
+    out.swap(pending_events);
+    return out.size();
+}
+
+} // namespace TotalMixer
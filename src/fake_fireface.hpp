@@ -0,0 +1,94 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "alsa_backend.hpp"
+
+namespace TotalMixer {
+
+// In-memory stand-in for a Fireface 400 behind snd-fireface-ctl. Exposes the same control set
+// the engine and GUI use (output-volume, mixer:*-source-gain, meter:*, metering and the Control
+// tab options) with the same names, counts and ranges, and behaves like the kernel does:
+// writes raise value events (signalled on an eventfd, like the ctl descriptor), reads of the
+// meters return a moving test signal while metering is on. Every operation can be given an
+// artificial latency so the cost of ALSA round-trips shows up in profiles and benchmarks the way
+// it does on the real FireWire link.
+//
+// Every backend call is serialized on an internal lock, like AlsaCore. stats(), reset_stats()
+// and latency() are not; use them while the engine is idle.
+class FakeFireface : public AlsaBackend {
+public:
+    // Simulated cost of each kind of operation (0 = free). Short delays are spun so they stay
+    // accurate; longer ones sleep.
+    struct Latency {
+        std::chrono::microseconds read{0};   // read / read_cached
+        std::chrono::microseconds write{0};  // write / write_element / each row of a commit
+        std::chrono::microseconds info{0};   // get_control_info / resolve
+    };
+
+    // Operation counters since construction (or the last reset_stats()).
+    struct Stats {
+        uint64_t reads = 0;
+        uint64_t writes = 0;
+        uint64_t infos = 0;
+        uint64_t events = 0; // events queued for the subscriber
+    };
+
+    FakeFireface();
+    explicit FakeFireface(Latency latency);
+    ~FakeFireface() override;
+
+    Latency& latency() { return lat; }
+    const Stats& stats() const { return counters; }
+    void reset_stats() { counters = Stats{}; }
+
+    // Simulates another ALSA client (alsamixer, a second mixer app) changing one element:
+    // updates the value and queues the event the kernel would send. Returns false if the
+    // control or element does not exist.
+    bool external_write(const std::string& name, unsigned int index, unsigned int element, long value);
+
+    // ── AlsaBackend ──
+    std::string get_card_name() override;
+    std::optional<ControlInfo> get_control_info(const std::string& name, unsigned int index = 0) override;
+    std::optional<ControlHandle> resolve(const std::string& name, unsigned int index = 0) override;
+    int read(const ControlHandle& h, long* out, unsigned int max_count) override;
+    using AlsaBackend::write;
+    bool write(const ControlHandle& h, const long* values, unsigned int count) override;
+    bool write_element(const ControlHandle& h, unsigned int element, long value) override;
+    bool commit(MatrixTransaction& txn) override;
+    bool subscribe_events() override;
+    bool events_subscribed() const override { return events_enabled; }
+    size_t read_events(std::vector<ControlEvent>& out) override;
+    int event_fd() const override { return events_enabled ? wake_fd : -1; }
+
+private:
+    struct Control {
+        std::string name;
+        unsigned int index = 0;
+        ControlInfo info;
+        std::vector<long> values;
+        bool meter = false; // read-only, value synthesized on read
+    };
+
+    std::recursive_mutex mtx;
+    Latency lat;
+    Stats counters;
+    std::vector<Control> controls; // numid = position + 1
+    std::vector<ControlEvent> pending_events;
+    bool events_enabled = false;
+    int wake_fd = -1;  // eventfd, readable while pending_events is non-empty
+    std::chrono::steady_clock::time_point started;
+
+    void add(const std::string& name, unsigned int index, ControlType type, unsigned int count,
+             long min, long max, bool writable = true, std::vector<std::string> items = {});
+    Control* find(const std::string& name, unsigned int index);
+    Control* at(const ControlHandle& h);
+    void queue_value_event(const Control& c);
+    void fill_meter(Control& c);
+    static void delay(std::chrono::microseconds d);
+};
+
+} // namespace TotalMixer
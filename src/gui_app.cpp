@@ -5,6 +5,7 @@
 #include "gui_app.hpp"
 #include "config_manager.hpp"
 #include "ui_helpers.hpp"
+#include <GLFW/glfw3.h>
 #include <iostream>
 #include <string>
 #include <cmath>
@@ -37,186 +38,248 @@ static std::vector<std::string> GetLocalIPv4Addresses() {
     return result;
 }
 
-bool TotalMixerGUI::ShouldWrite(ImGuiID id) {
-    auto now = std::chrono::steady_clock::now();
-    if (last_widget_write_time.find(id) == last_widget_write_time.end()) {
-        last_widget_write_time[id] = now;
-        return true;
+// ── Crosspoint gain popup (right-click on a matrix cell) ──
+// dB entry plus presets; returns true when *value was changed.
+static bool CrosspointGainPopup(const char* popup_id, const char* title, long* value) {
+    if (!ImGui::BeginPopup(popup_id)) return false;
+    bool value_changed = false;
+    ImGui::Text("Matrix Gain %s: %s", title, val_to_db_cstr(*value));
+    ImGui::Separator();
+
+    static char input_buffer[16];
+    if (ImGui::IsWindowAppearing()) val_to_db_buf(*value, input_buffer, sizeof(input_buffer), false);
+
+    ImGui::SetNextItemWidth(120);
+    if (ImGui::InputText("##db_input", input_buffer, sizeof(input_buffer), ImGuiInputTextFlags_EnterReturnsTrue)) {
+        *value = db_cstr_to_val(input_buffer);
+        value_changed = true;
+        ImGui::CloseCurrentPopup();
     }
-    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_widget_write_time[id]).count();
-    if (elapsed > 50) { 
-        last_widget_write_time[id] = now;
-        return true;
+    ImGui::SameLine(); ImGui::Text("dB");
+
+    ImGui::Spacing();
+    ImGui::TextDisabled("Presets:");
+
+    float presets[] = {6.0f, 0.0f, -5.0f, -10.0f, -15.0f, -20.0f, -30.0f, -40.0f, -50.0f};
+    for (int i = 0; i < 9; i++) {
+        char b_lab[16];
+        snprintf(b_lab, sizeof(b_lab), "%+.1f", presets[i]);
+        if (ImGui::Button(b_lab, ImVec2(50, 0))) {
+            *value = db_cstr_to_val(b_lab);
+            value_changed = true;
+            ImGui::CloseCurrentPopup();
+        }
+        if ((i + 1) % 3 != 0) ImGui::SameLine();
     }
-    return false;
+
+    if (ImGui::Button("-inf (Mute)", ImVec2(160, 0))) {
+        *value = 0;
+        value_changed = true;
+        ImGui::CloseCurrentPopup();
+    }
+
+    ImGui::EndPopup();
+    return value_changed;
 }
 
-// Helper: Square Slider Implementation
-bool TotalMixerGUI::SquareSlider(const char* label, long* value, int min_v, int max_v, const ImVec2& size) {
+// ── DrawMatrixGrid: the crosspoint grid as one custom widget ──
+// Every section contributes an optional divider row plus 18 source rows against the 18 outputs.
+// The grid is a single item: the hovered cell is found from the mouse position, only the cells
+// inside the window's clip rect are emitted into its draw list, and the header row and label
+// column stay pinned to the visible edges while the child window scrolls. Cells behave like
+// the old per-cell sliders: drag vertically, wheel in knob steps, right-click for a dB entry.
+void TotalMixerGUI::DrawMatrixGrid(const char* str_id, const char* corner_label,
+                                   const MatrixSection* sections, int section_count) {
     ImGuiWindow* window = ImGui::GetCurrentWindow();
-    if (window->SkipItems) return false;
-
+    if (window->SkipItems) return;
     ImGuiContext& g = *GImGui;
-    const ImGuiStyle& style = g.Style;
-    const ImGuiID id = window->GetID(label);
-
-    const ImRect frame_bb(window->DC.CursorPos, ImVec2(window->DC.CursorPos.x + size.x, window->DC.CursorPos.y + size.y));
-    const ImRect total_bb(frame_bb.Min, frame_bb.Max);
-
-    ImGui::ItemSize(total_bb, style.FramePadding.y);
-    if (!ImGui::ItemAdd(total_bb, id, &frame_bb)) return false;
-
-    const bool hovered = ImGui::ItemHoverable(frame_bb, id, 0); 
-    bool temp_input_is_active = ImGui::TempInputIsActive(id);
-    if (!temp_input_is_active) {
-        const bool clicked = hovered && ImGui::IsMouseClicked(0, false);
-        if (clicked) {
-            ImGui::SetActiveID(id, window);
-            ImGui::SetFocusID(id, window);
-            ImGui::FocusWindow(window);
-            g.ActiveIdUsingNavDirMask |= (1 << ImGuiDir_Up) | (1 << ImGuiDir_Down);
+
+    const float label_w = 60.0f;
+    const float pitch_x = 45.0f, pitch_y = 44.0f;  // cell + gap, the old table column/row size
+    const float cell = 40.0f;
+    const float header_h = ImGui::GetTextLineHeightWithSpacing() + 4.0f;
+    const float divider_h = ImGui::GetTextLineHeightWithSpacing() + 4.0f;
+    const long max_v = 65536;
+    const float range = (float)max_v;
+
+    // Vertical layout: header, then per section its divider (if titled) and 18 rows.
+    float rows_top[2] = {0.0f, 0.0f};  // relative to the grid origin
+    float y = header_h;
+    for (int s = 0; s < section_count && s < 2; ++s) {
+        if (sections[s].title) y += divider_h;
+        rows_top[s] = y;
+        y += 18 * pitch_y;
+    }
+    const ImVec2 origin = window->DC.CursorPos;
+    const ImRect bb(origin, ImVec2(origin.x + label_w + 18 * pitch_x, origin.y + y));
+    const ImGuiID id = window->GetID(str_id);
+    ImGui::ItemSize(bb);
+    if (!ImGui::ItemAdd(bb, id)) return;
+
+    const ImRect clip = window->ClipRect;
+    const float head_y = ImMax(origin.y, clip.Min.y);     // pinned header row
+    const float label_x = ImMax(origin.x, clip.Min.x);    // pinned label column
+    const float cells_x = origin.x + label_w;
+
+    // ── Hit test: mouse position -> (section, output, source) ──
+    struct Hit { int section = -1; int out = 0; int src = 0; };
+    Hit hit;
+    const bool hovered = ImGui::ItemHoverable(bb, id, 0);
+    if (hovered) {
+        ImVec2 m = g.IO.MousePos;
+        if (m.y >= head_y + header_h && m.x >= label_x + label_w) {
+            float fx = (m.x - cells_x) / pitch_x;
+            int col = (int)fx;
+            for (int s = 0; s < section_count && s < 2; ++s) {
+                float fy = (m.y - (origin.y + rows_top[s])) / pitch_y;
+                int row = (int)fy;
+                if (fy < 0.0f || row >= 18 || col < 0 || col >= 18) continue;
+                // Only the cell itself, not the gap around it, takes input.
+                if ((fx - col) * pitch_x > cell || (fy - row) * pitch_y > cell) continue;
+                hit.section = s;
+                hit.out = col;
+                hit.src = row;
+            }
         }
     }
 
-    bool value_changed = false;
-
-    // Mouse Wheel Support
-    if (hovered && g.IO.MouseWheel != 0.0f) {
-        float wheel_delta = g.IO.MouseWheel;
-        float range = (float)(max_v - min_v);
-        float step = range / 63.0f; // Step by one hardware knob unit
-        
-        float v_float = (float)*value;
-        v_float += wheel_delta * step;
-        
-        if (v_float < (float)min_v) v_float = (float)min_v;
-        if (v_float > (float)max_v) v_float = (float)max_v;
-        
-        // Snap to 0 if very close to bottom to ensure Mute
-        if (v_float < (range / 200.0f)) v_float = 0.0f;
-
-        *value = (long)v_float;
-        value_changed = true;
-        
-        // Consume the wheel event so Table scroll doesn't also process it
+    // ── Interaction ──
+    long new_value = -1;
+    Hit edit;
+    if (hit.section >= 0 && ImGui::IsMouseClicked(0, false)) {
+        ImGui::SetActiveID(id, window);
+        ImGui::SetFocusID(id, window);
+        ImGui::FocusWindow(window);
+        g.ActiveIdUsingNavDirMask |= (1 << ImGuiDir_Up) | (1 << ImGuiDir_Down);
+        matrix_drag_ = {sections[hit.section].is_playback, hit.out, hit.src};
+        matrix_drag_id_ = id;
+    }
+    if (hit.section >= 0 && g.IO.MouseWheel != 0.0f) {
+        const MatrixSection& sec = sections[hit.section];
+        float v = (float)view_.crosspoint(sec.is_playback, hit.out, hit.src);
+        v = ImClamp(v + g.IO.MouseWheel * (range / 63.0f), 0.0f, range);  // one knob unit
+        if (v < range / 200.0f) v = 0.0f;                                  // snap to mute
+        new_value = (long)v;
+        edit = hit;
+        // Keep the wheel from also scrolling the window.
+        ImGui::SetItemKeyOwner(ImGuiKey_MouseWheelY);
         g.IO.MouseWheel = 0.0f;
     }
-
-    if (g.ActiveId == id) {
-        if (g.ActiveIdSource == ImGuiInputSource_Mouse) {
-            if (!g.IO.MouseDown[0]) {
-                ImGui::ClearActiveID();
-            } else {
-                float mouse_delta = g.IO.MouseDelta.y;
-                if (mouse_delta != 0.0f) {
-                    float speed = (g.IO.KeyShift ? 10.0f : 150.0f);
-                    float range = (float)(max_v - min_v);
-                    float step = range / (200.0f); 
-                    
-                    float v_float = (float)*value;
-                    v_float -= mouse_delta * step; 
-                    
-                    if (v_float < (float)min_v) v_float = (float)min_v;
-                    if (v_float > (float)max_v) v_float = (float)max_v;
-                    
-                    // Snap to 0 if very close to bottom
-                    if (v_float < (range / 200.0f)) v_float = 0.0f;
-
-                    *value = (long)v_float;
-                    value_changed = true;
-                }
-            }
+    const bool dragging = (g.ActiveId == id && matrix_drag_id_ == id);
+    if (dragging && g.ActiveIdSource == ImGuiInputSource_Mouse) {
+        if (!g.IO.MouseDown[0]) {
+            ImGui::ClearActiveID();
+        } else if (g.IO.MouseDelta.y != 0.0f) {
+            float v = (float)view_.crosspoint(matrix_drag_.is_playback, matrix_drag_.out, matrix_drag_.src);
+            v = ImClamp(v - g.IO.MouseDelta.y * (range / 200.0f), 0.0f, range);
+            if (v < range / 200.0f) v = 0.0f;
+            new_value = (long)v;
+            edit.section = -2;  // the drag cell
         }
     }
+    if (hit.section >= 0 && ImGui::IsMouseClicked(1)) {
+        matrix_popup_ = {sections[hit.section].is_playback, hit.out, hit.src};
+        ImGui::PushID(str_id);
+        ImGui::OpenPopup("##cell_popup");
+        ImGui::PopID();
+    }
 
-    ImU32 frame_col = ImGui::GetColorU32(g.ActiveId == id ? ImGuiCol_FrameBgActive : hovered ? ImGuiCol_FrameBgHovered : ImGuiCol_FrameBg);
-    ImGui::RenderNavHighlight(frame_bb, id);
-    
-    window->DrawList->AddRectFilled(frame_bb.Min, frame_bb.Max, ImGui::GetColorU32(ImVec4(0.15f, 0.15f, 0.15f, 1.0f)));
-    
-    float range = (float)(max_v - min_v);
-    float t = (*value - min_v) / range;
-    t = ImClamp(t, 0.0f, 1.0f);
-    
-    float fill_h = size.y * t;
-    ImRect fill_bb = frame_bb;
-    fill_bb.Min.y = frame_bb.Max.y - fill_h;
-    
-    ImVec4 fill_color = (*value > 59294) ? ImVec4(1.0f, 0.4f, 0.0f, 1.0f) : ImVec4(0.0f, 0.7f, 0.0f, 1.0f);
-    window->DrawList->AddRectFilled(fill_bb.Min, fill_bb.Max, ImGui::GetColorU32(fill_color));
-    
-    window->DrawList->AddRect(frame_bb.Min, frame_bb.Max, ImGui::GetColorU32(ImVec4(0.3f, 0.3f, 0.3f, 1.0f)));
-    
-    std::string db_str = val_to_db_str(*value);
-    ImVec2 text_size = ImGui::CalcTextSize(db_str.c_str());
-    ImVec2 text_pos = ImVec2(frame_bb.Min.x + (size.x - text_size.x) * 0.5f, frame_bb.Min.y + (size.y - text_size.y) * 0.5f);
-    window->DrawList->AddText(text_pos, ImGui::GetColorU32(ImVec4(0.9f, 0.9f, 0.9f, 1.0f)), db_str.c_str());
-
-    // Right-click Popup for Matrix Slider
-    std::string popup_id = "MatPopup_" + std::string(label);
-    if (hovered && ImGui::IsMouseClicked(1)) {
-        ImGui::OpenPopup(popup_id.c_str());
+    // Apply an edit to the view's copy of the cell (so the drag stays smooth) and write the
+    // single crosspoint; the engine's write queue coalesces per-frame edits.
+    auto apply = [this](const MatrixCell& c, long value) {
+        long& val = view_.crosspoint(c.is_playback, c.out, c.src);
+        if (value == val) return;
+        val = value;
+        if (engine_.connected()) view_.WriteCrosspointRaw(c.is_playback, c.src, c.out, val);
+    };
+    if (new_value >= 0) {
+        if (edit.section == -2) apply(matrix_drag_, new_value);
+        else apply({sections[edit.section].is_playback, edit.out, edit.src}, new_value);
     }
 
-    if (ImGui::BeginPopup(popup_id.c_str())) {
-        ImGui::Text("Matrix Gain: %s -> %s", label, db_str.c_str());
-        ImGui::Separator();
-        
-        static std::string input_buffer;
-        if (ImGui::IsWindowAppearing()) {
-            input_buffer = val_to_db_str(*value);
-            if (!input_buffer.empty() && input_buffer[0] == '+') input_buffer = input_buffer.substr(1);
+    // Hold the dragged cell against snapshots until the mouse is released.
+    if (g.ActiveId == id && matrix_drag_id_ == id) {
+        view_.HoldCrosspoint(matrix_drag_.is_playback, matrix_drag_.out, matrix_drag_.src);
+    } else if (matrix_drag_id_ == id) {
+        if (view_.isHeldCrosspoint(matrix_drag_.is_playback, matrix_drag_.out, matrix_drag_.src)) {
+            view_.ReleaseHeld();
         }
+        matrix_drag_id_ = 0;
+    }
 
-        ImGui::SetNextItemWidth(120);
-        if (ImGui::InputText("##db_input", &input_buffer, ImGuiInputTextFlags_EnterReturnsTrue)) {
-            *value = db_str_to_val(input_buffer);
-            value_changed = true;
-            ImGui::CloseCurrentPopup();
+    // ── Cells: one pass over the visible ones ──
+    ImDrawList* dl = window->DrawList;
+    const ImU32 col_well = ImGui::GetColorU32(ImVec4(0.15f, 0.15f, 0.15f, 1.0f));
+    const ImU32 col_fill = ImGui::GetColorU32(ImVec4(0.0f, 0.7f, 0.0f, 1.0f));
+    const ImU32 col_hot = ImGui::GetColorU32(ImVec4(1.0f, 0.4f, 0.0f, 1.0f));
+    const ImU32 col_border = ImGui::GetColorU32(ImVec4(0.3f, 0.3f, 0.3f, 1.0f));
+    const ImU32 col_text = ImGui::GetColorU32(ImVec4(0.9f, 0.9f, 0.9f, 1.0f));
+    const int c0 = ImClamp((int)((clip.Min.x - cells_x) / pitch_x), 0, 17);
+    const int c1 = ImClamp((int)((clip.Max.x - cells_x) / pitch_x), 0, 17);
+    for (int s = 0; s < section_count && s < 2; ++s) {
+        const bool is_playback = sections[s].is_playback;
+        const float top = origin.y + rows_top[s];
+        if (top + 18 * pitch_y < clip.Min.y || top > clip.Max.y) continue;
+        const int r0 = ImClamp((int)((clip.Min.y - top) / pitch_y), 0, 17);
+        const int r1 = ImClamp((int)((clip.Max.y - top) / pitch_y), 0, 17);
+        for (int r = r0; r <= r1; ++r) {
+            for (int c = c0; c <= c1; ++c) {
+                const long v = view_.crosspoint(is_playback, c, r);
+                const ImVec2 p0(cells_x + c * pitch_x, top + r * pitch_y);
+                const ImVec2 p1(p0.x + cell, p0.y + cell);
+                dl->AddRectFilled(p0, p1, col_well);
+                float t = ImClamp((float)v / range, 0.0f, 1.0f);
+                if (t > 0.0f) dl->AddRectFilled(ImVec2(p0.x, p1.y - cell * t), p1, v > 59294 ? col_hot : col_fill);
+                dl->AddRect(p0, p1, col_border);
+                const char* db = val_to_db_cstr(v);
+                ImVec2 ts = ImGui::CalcTextSize(db);
+                dl->AddText(ImVec2(p0.x + (cell - ts.x) * 0.5f, p0.y + (cell - ts.y) * 0.5f), col_text, db);
+            }
         }
-        ImGui::SameLine(); ImGui::Text("dB");
+    }
 
-        ImGui::Spacing();
-        ImGui::TextDisabled("Presets:");
-        
-        float presets[] = {6.0f, 0.0f, -5.0f, -10.0f, -15.0f, -20.0f, -30.0f, -40.0f, -50.0f};
-        for (int i = 0; i < 9; i++) {
-            char b_lab[16];
-            snprintf(b_lab, sizeof(b_lab), "%+.1f", presets[i]);
-            if (ImGui::Button(b_lab, ImVec2(50, 0))) {
-                *value = db_str_to_val(std::string(b_lab));
-                value_changed = true;
-                ImGui::CloseCurrentPopup();
-            }
-            if ((i + 1) % 3 != 0) ImGui::SameLine();
+    // ── Pinned label column and header row (drawn over the scrolled cells) ──
+    const ImU32 col_bg = ImGui::GetColorU32(ImGuiCol_WindowBg) | IM_COL32_A_MASK;
+    const ImU32 col_head_bg = ImGui::GetColorU32(ImGuiCol_TableHeaderBg);
+    const ImU32 col_label = ImGui::GetColorU32(ImGuiCol_Text);
+    const ImU32 col_divider = ImGui::GetColorU32(ImVec4(0.6f, 0.8f, 1.0f, 1.0f));
+    const float text_h = ImGui::GetTextLineHeight();
+    dl->AddRectFilled(ImVec2(label_x, clip.Min.y), ImVec2(label_x + label_w, clip.Max.y), col_bg);
+    for (int s = 0; s < section_count && s < 2; ++s) {
+        const float top = origin.y + rows_top[s];
+        if (sections[s].title) {
+            dl->AddText(ImVec2(label_x + 4.0f, top - divider_h + 2.0f), col_divider, sections[s].title);
         }
-        
-        if (ImGui::Button("-inf (Mute)", ImVec2(160, 0))) {
-            *value = 0;
-            value_changed = true;
-            ImGui::CloseCurrentPopup();
+        const std::vector<std::string>& labels = *sections[s].labels;
+        for (int r = 0; r < 18; ++r) {
+            float ry = top + r * pitch_y;
+            if (ry + pitch_y < clip.Min.y || ry > clip.Max.y) continue;
+            dl->AddText(ImVec2(label_x + 4.0f, ry + (cell - text_h) * 0.5f), col_label, labels[r].c_str());
         }
-
-        ImGui::EndPopup();
+    }
+    dl->AddRectFilled(ImVec2(label_x, head_y), ImVec2(clip.Max.x, head_y + header_h), col_bg);
+    dl->AddRectFilled(ImVec2(label_x, head_y), ImVec2(clip.Max.x, head_y + header_h), col_head_bg);
+    dl->AddText(ImVec2(label_x + 4.0f, head_y + 2.0f), col_label, corner_label);
+    for (int c = c0; c <= c1; ++c) {
+        float cx = cells_x + c * pitch_x;
+        if (cx + pitch_x <= label_x + label_w) continue;  // under the pinned label column
+        dl->AddText(ImVec2(cx + 2.0f, head_y + 2.0f), col_label, out_labels[c].c_str());
     }
 
-    return value_changed;
+    // The right-click popup for whichever cell opened it.
+    ImGui::PushID(str_id);
+    long& popup_val = view_.crosspoint(matrix_popup_.is_playback, matrix_popup_.out, matrix_popup_.src);
+    long popup_edit = popup_val;
+    char title[64];
+    const std::vector<std::string>& src_labels = matrix_popup_.is_playback ? stream_labels : in_labels;
+    snprintf(title, sizeof(title), "%s -> %s", src_labels[matrix_popup_.src].c_str(),
+             out_labels[matrix_popup_.out].c_str());
+    if (CrosspointGainPopup("##cell_popup", title, &popup_edit)) apply(matrix_popup_, popup_edit);
+    ImGui::PopID();
 }
 
 // ── Meter Helper Functions ──
-// Meter display scale: linear amplitude is mapped onto a -kMeterFloorDB .. 0 dBFS bar
-// (RME TotalMix-style wide range so low-level inputs like mics remain visible).
-static constexpr float kMeterFloorDB = 90.0f;
-// Peak-hold line fall rate (display units per second) after the hold time expires.
-static constexpr float kPeakDecayPerSec = 0.30f;
-
-// Map a linear amplitude [0,1] to a display position [0,1] on the dBFS scale above.
-static inline float MeterLinToDisplay(float lin) {
-    if (lin <= 1e-12f) return 0.0f;
-    float db = 20.0f * log10f(lin);
-    return ImClamp((db + kMeterFloorDB) / kMeterFloorDB, 0.0f, 1.0f);
-}
-
+// Levels arrive already mapped onto the display scale (see MeterBank).
 static ImVec4 GetMeterColor(float normalized_db) {
     if (normalized_db < 0.2f) {
         float t = normalized_db / 0.2f;
@@ -257,7 +320,7 @@ void TotalMixerGUI::DrawMeterBar(const char* label, const MeterLevel& meter, con
     }
 
     // Peak-hold line: a distinct held marker that sits above the RMS fill, colored by its
-    // own level so it reads clearly (fast attack, slow decay handled in PollMeters).
+    // own level so it reads clearly (fast attack, slow decay handled by the engine's MeterBank).
     if (meter.peak_norm > 0.0f) {
         float peak_y = frame_bb.Max.y - meter.peak_norm * size.y;
         ImU32 peak_col = ImGui::ColorConvertFloat4ToU32(GetMeterColor(meter.peak_norm));
@@ -302,15 +365,13 @@ TotalMixerGUI::TotalMixerGUI()
         "ADAT 1", "ADAT 2", "ADAT 3", "ADAT 4", "ADAT 5", "ADAT 6", "ADAT 7", "ADAT 8"
     };
 
-    master_meters.resize(18);
-    input_meters.resize(18);
-    stream_meters.resize(18);
     stream_labels = {
         "PB 1", "PB 2", "PB 3", "PB 4", "PB 5", "PB 6",
         "PB 7", "PB 8", "PB 9", "PB 10", "PB 11", "PB 12",
         "PB 13", "PB 14", "PB 15", "PB 16", "PB 17", "PB 18"
     };
-    last_meter_poll_time = std::chrono::steady_clock::now();
+    // Meters are polled by the engine and arrive with each snapshot.
+    engine_.SetMetersEnabled(true);
 
     // The engine loaded preferences in its constructor; honor the persisted OSC enable state
     // (the daemon forces OSC on, but the GUI respects the user's choice).
@@ -327,147 +388,41 @@ TotalMixerGUI::TotalMixerGUI()
         connection_status = res.connected ? ConnectionStatus::Connected
                                           : ConnectionStatus::HardwareNotFound;
     }
+
+    // From here on the engine services OSC, polling and writes on its own thread. Changes it
+    // picks up from OSC or the card post an empty GLFW event, so a frame loop blocked in
+    // glfwWaitEvents wakes to draw them.
+    engine_.SetChangeListener([] { glfwPostEmptyEvent(); });
+    engine_.StartThread();
 }
 
 TotalMixerGUI::~TotalMixerGUI() {}
 
-void TotalMixerGUI::PollMeters() {
-    AlsaCore* alsa = engine_.alsa();
-    if (!alsa) return;
-    try {
-        // ── Cache raw value ranges for each meter control (query once from ALSA) ──
-        static long ao_min = 0, ao_range = 1;
-        static long so_min = 0, so_range = 1;
-        static long ad_min = 0, ad_range = 1;
-        static long ai_min = 0, ai_range = 1;
-        static long spi_min = 0, spi_range = 1;
-        static long adi_min = 0, adi_range = 1;
-        static long si_min = 0, si_range = 1;
-        static bool range_initialized = false;
-        if (!range_initialized) {
-            // Enable hardware metering. The daemon only (re)starts its meter timer on a
-            // 0->1 transition of this control; if it was left at 1 from a previous session,
-            // writing 1 again is a no-op and meters stay frozen. Force the edge with 0 then 1.
-            alsa->set_control_value("metering", 0, 0);
-            if (alsa->set_control_value("metering", 0, 1)) {
-                std::cout << "[METER] Hardware metering enabled (forced 0->1 edge)" << std::endl;
-            } else {
-                std::cerr << "[METER] Warning: failed to enable metering" << std::endl;
-            }
-
-            auto init_range = [alsa](const std::string& name, long& out_min, long& out_range) {
-                auto info = alsa->get_control_info(name, 0);
-                if (info) {
-                    out_min = info->min;
-                    out_range = info->max - info->min;
-                    if (out_range <= 0) out_range = 1;
-                    std::cout << "[METER] " << name << " raw range: "
-                              << info->min << " .. " << info->max << std::endl;
-                }
-            };
-            init_range("meter:analog-output", ao_min, ao_range);
-            init_range("meter:spdif-output", so_min, so_range);
-            init_range("meter:adat-output", ad_min, ad_range);
-            init_range("meter:analog-input", ai_min, ai_range);
-            init_range("meter:spdif-input", spi_min, spi_range);
-            init_range("meter:adat-input", adi_min, adi_range);
-            init_range("meter:stream-input", si_min, si_range);
-            range_initialized = true;
-        }
-
-        // Compute delta time for peak hold decay
-        auto now = std::chrono::steady_clock::now();
-        float dt = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_meter_poll_time).count() / 1000.0f;
-        if (dt < 0.001f) dt = 0.1f;
-
-        // Helper: read one meter control, normalize all elements, update dest vector
-        auto read_meter = [&, this](std::vector<MeterLevel>& dest, const std::string& name,
-                              long raw_min, long raw_range, int start_idx, int count) {
-            auto val = alsa->get_control_value(name, 0);
-            if (!val || (int)val->int_values.size() < count) return;
-
-            for (int i = 0; i < count; ++i) {
-                int idx = start_idx + i;
-                if (idx < 0 || idx >= (int)dest.size()) break;
-
-                // Normalize raw value to [0, 1] linear amplitude
-                float norm = (val->int_values[i] - raw_min) / (float)raw_range;
-                norm = ImClamp(norm, 0.0f, 1.0f);
-
-                MeterLevel& m = dest[idx];
-
-                // Instantaneous level (drives the peak follower + overload detection)
-                float inst_display = MeterLinToDisplay(norm);
-
-                // RMS (EMA of squared linear amplitude) -> the filled bar body
-                float rms_alpha = 1.0f - expf(-dt / engine_.meterPrefs().rms_tau_seconds);
-                m.rms_sq_ema = rms_alpha * (norm * norm) + (1.0f - rms_alpha) * m.rms_sq_ema;
-                float rms_lin = sqrtf(m.rms_sq_ema);
-                // +3dB correction applied as a linear scale (10^(3/20) ≈ 1.41254) before mapping
-                if (engine_.meterPrefs().rms_plus_3db) rms_lin *= 1.41254f;
-                m.rms_normalized = MeterLinToDisplay(rms_lin);
-
-                // Peak follower: instant attack, hold for peak_hold_seconds, then slow decay
-                // toward the instantaneous level. Drawn as a separate held line (no flicker
-                // against the RMS fill since they are distinct visual elements).
-                if (inst_display >= m.peak_norm) {
-                    m.peak_norm = inst_display;
-                    m.peak_hold_time = 0.0f;
-                } else {
-                    m.peak_hold_time += dt;
-                    if (m.peak_hold_time >= engine_.meterPrefs().peak_hold_seconds) {
-                        m.peak_norm -= kPeakDecayPerSec * dt;
-                        if (m.peak_norm < inst_display) m.peak_norm = inst_display;
-                    }
-                }
-
-                // Overload: instantaneous level at/above ~-0.5 dBFS (near digital full scale)
-                static const float kOvrDisplay = (-0.5f + kMeterFloorDB) / kMeterFloorDB;
-                if (inst_display >= kOvrDisplay) {
-                    m.overload_count++;
-                    m.is_overload = (m.overload_count >= engine_.meterPrefs().ovr_sample_count);
-                } else {
-                    m.overload_count = 0;
-                    m.is_overload = false;
-                }
-                m.normalized = inst_display;
-            }
-        };
-
-        // Master section: ch 0-7 = analog-out, 8-9 = spdif-out, 10-17 = adat-out
-        read_meter(master_meters, "meter:analog-output", ao_min, ao_range, 0, 8);
-        read_meter(master_meters, "meter:spdif-output",   so_min, so_range, 8, 2);
-        read_meter(master_meters, "meter:adat-output",    ad_min, ad_range, 10, 8);
-
-        // Input section: ch 0-7 = analog-in, 8-9 = spdif-in, 10-17 = adat-in
-        read_meter(input_meters, "meter:analog-input", ai_min, ai_range, 0, 8);
-        read_meter(input_meters, "meter:spdif-input", spi_min, spi_range, 8, 2);
-        read_meter(input_meters, "meter:adat-input", adi_min, adi_range, 10, 8);
-
-        // Stream section: ch 0-17 = stream-input
-        read_meter(stream_meters, "meter:stream-input", si_min, si_range, 0, 18);
-    } catch (...) {}
-}
-
 void TotalMixerGUI::Render() {
-    auto now = std::chrono::steady_clock::now();
-
-    // One engine service cycle: drain+apply inbound OSC, throttled hardware poll (skipped while
-    // a widget is being dragged), and throttled OSC diff push. The engine owns all this timing.
+    // The engine thread does the service cycle (OSC, polling, OSC push); tell it whether a widget
+    // is being dragged so it skips the hardware poll, then take this frame's snapshot.
     bool any_widget_active = (ImGui::GetActiveID() != 0);
-    engine_.Tick(any_widget_active);
+    engine_.SetInputsBusy(any_widget_active);
+    view_.Sync();
+    if (hidden_) {
+        engine_.SetMetersEnabled(true);
+        hidden_ = false;
+    }
+
+    // Frames-per-second readout for Preferences > Display.
+    fps_frames_++;
+    auto fps_now = std::chrono::steady_clock::now();
+    double fps_secs = std::chrono::duration<double>(fps_now - fps_window_start_).count();
+    if (fps_secs >= 1.0) {
+        fps_ = (float)(fps_frames_ / fps_secs);
+        fps_frames_ = 0;
+        fps_window_start_ = fps_now;
+    }
 
     // Reap the web-remote bridge child if it exited (crash or its own systemd/user stop), so it
     // never lingers as a zombie regardless of which tab is visible.
     bridge_.Poll();
 
-    // Meter polling at ~33ms interval (≈30Hz) stays in the GUI (display-only, not in the engine).
-    auto meter_elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_meter_poll_time).count();
-    if (meter_elapsed > 33) {
-        PollMeters();
-        last_meter_poll_time = now;
-    }
-
     // F2 shortcut to toggle Preferences dialog
     if (ImGui::IsKeyPressed(ImGuiKey_F2, false)) {
         show_prefs_dialog = !show_prefs_dialog;
@@ -483,6 +438,11 @@ void TotalMixerGUI::Render() {
     
     ImGui::Begin("Main", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse);
 
+    // The engine thread notices an unplugged card; show it and offer the retry below.
+    if (connection_status == ConnectionStatus::Connected && engine_.hardwareLost()) {
+        connection_status = ConnectionStatus::HardwareDisconnected;
+    }
+
     DrawHeader();
     
     bool ui_enabled = (connection_status == ConnectionStatus::Connected);
@@ -501,6 +461,15 @@ void TotalMixerGUI::Render() {
             DrawCombinedMatrixTab();
             ImGui::EndTabItem();
         }
+        history_busy_ = false;
+        if (ImGui::BeginTabItem("History")) {
+            DrawHistoryTab();
+            ImGui::EndTabItem();
+        }
+        if (ImGui::BeginTabItem("Overloads")) {
+            DrawOverloadsTab();
+            ImGui::EndTabItem();
+        }
         if (ImGui::BeginTabItem("Control")) {
             DrawControlTab();
             ImGui::EndTabItem();
@@ -520,6 +489,38 @@ void TotalMixerGUI::Render() {
     ImGui::End();
 }
 
+void TotalMixerGUI::RenderHidden() {
+    bridge_.Poll();
+    if (!hidden_) {
+        engine_.SetMetersEnabled(false);
+        hidden_ = true;
+    }
+    fps_ = 0.0f;
+    fps_frames_ = 0;
+    fps_window_start_ = std::chrono::steady_clock::now();
+}
+
+// ── Frame pacing ──
+bool TotalMixerGUI::MetersMoving() const {
+    auto moving = [](const MeterLevel& m) {
+        return m.normalized > 0.0f || m.rms_normalized > 0.0f || m.peak_norm > 0.0f || m.is_overload;
+    };
+    for (int i = 0; i < 18; ++i) {
+        if (moving(view_.outputMeter(i)) || moving(view_.inputMeter(i)) || moving(view_.playbackMeter(i))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TotalMixerGUI::WantsActiveFrames(double now) {
+    // A second of grace after input covers hover highlights, tooltip delays and popups that
+    // take a few frames to settle.
+    frames_active_ = (now - last_input_time_ < 1.0) || ImGui::GetActiveID() != 0 || MetersMoving() ||
+                     history_busy_;
+    return frames_active_;
+}
+
 void TotalMixerGUI::DrawHeader() {
     std::string info_str;
     
@@ -546,6 +547,7 @@ void TotalMixerGUI::DrawHeader() {
                 info_str += "Setup guide:\n";
                 info_str += "https://github.com/oudeis01/linux-fireface-mixer#installation";
                 break;
+            case ConnectionStatus::HardwareDisconnected:
             default:
                 info_str = "ERROR: Hardware Disconnected";
                 break;
@@ -582,6 +584,9 @@ void TotalMixerGUI::DrawHeader() {
         }
         
         if (ImGui::Button("Retry Connection")) {
+            // Handles belong to the previous connection; resolve again on next use.
+            control_tab_resolved = false;
+            engine_.StopThread();
             MixerEngine::InitResult res = engine_.Init();
             service_status = res.service;
             if (res.service != ServiceStatus::Running) {
@@ -592,6 +597,7 @@ void TotalMixerGUI::DrawHeader() {
                 connection_status = res.connected ? ConnectionStatus::Connected
                                                   : ConnectionStatus::HardwareNotFound;
             }
+            engine_.StartThread();
         }
         
         ImGui::Separator();
@@ -684,26 +690,44 @@ void TotalMixerGUI::DrawControlTab() {
         {"S/PDIF Config", {"spdif-input-interface", "spdif-output-format", "spdif-output-non-audio"}}
     };
 
-    AlsaCore* alsa = engine_.alsa();
+    AlsaBackend* alsa = engine_.alsa();
+
+    // Resolve every listed control once; the per-frame path below only reads through handles.
+    if (alsa && !control_tab_resolved) {
+        control_tab_entries.clear();
+        for (const auto& grp : groups) {
+            for (const char* c_name : grp.controls) {
+                ControlTabEntry& e = control_tab_entries.emplace_back();
+                auto h = alsa->resolve(c_name, 0);
+                auto info = alsa->get_control_info(c_name, 0);
+                if (!h || !info) continue;
+                e.ctl = *h;
+                e.enum_items = info->enum_items;
+                for (const auto& item : e.enum_items) e.enum_item_ptrs.push_back(item.c_str());
+            }
+        }
+        control_tab_resolved = true;
+    }
 
     ImGui::BeginChild("ControlTab", ImVec2(0,0), true);
     ImGui::Columns(2, "ControlCols", false);
 
+    size_t entry_idx = 0;
+
     for (const auto& grp : groups) {
         ImGui::BeginGroup();
         ImGui::TextColored(ImVec4(0.6f, 0.8f, 1.0f, 1.0f), "[ %s ]", grp.name);
         ImGui::Separator();
 
         for (const char* c_name : grp.controls) {
-            if (!alsa) continue;
-            auto info = alsa->get_control_info(c_name, 0);
-            if (!info) continue;
-            auto val = alsa->get_control_value(c_name, 0);
-            if (!val) continue;
+            size_t this_idx = entry_idx++;
+            if (!alsa || this_idx >= control_tab_entries.size()) continue;
+            ControlTabEntry& entry = control_tab_entries[this_idx];
+            if (!entry.ctl.valid()) continue;
 
-            int count = info->count;
-            std::vector<long> values = val->int_values;
-            if (values.size() < (size_t)count) values.resize(count, values.empty() ? 0 : values[0]);
+            long values[16];
+            int count = alsa->read(entry.ctl, values, 16);
+            if (count <= 0) continue;
 
             for (int i = 0; i < count; ++i) {
                 ImGui::PushID(c_name); ImGui::PushID(i);
@@ -712,25 +736,21 @@ void TotalMixerGUI::DrawControlTab() {
                 
                 ImGui::Text("%s:", label.c_str()); ImGui::SameLine(200); 
                 
-                if (info->type == "Enum") {
+                if (entry.ctl.type == ControlType::Enum) {
                     int current_idx = (int)values[i];
-                    if (current_idx >= 0 && current_idx < (int)info->enum_items.size()) {
-                        // ImGui Combo
-                        // Need const char* array for combo
-                        std::vector<const char*> items;
-                        for (const auto& s : info->enum_items) items.push_back(s.c_str());
-                        
+                    if (current_idx >= 0 && current_idx < (int)entry.enum_item_ptrs.size()) {
                         int temp_idx = current_idx;
-                        if (ImGui::Combo("##combo", &temp_idx, items.data(), items.size())) {
+                        if (ImGui::Combo("##combo", &temp_idx, entry.enum_item_ptrs.data(),
+                                         (int)entry.enum_item_ptrs.size())) {
                             values[i] = temp_idx;
-                            alsa->set_control_value(c_name, 0, values);
+                            alsa->write(entry.ctl, values, count);
                         }
                     }
-                } else if (info->type == "Bool") {
+                } else if (entry.ctl.type == ControlType::Bool) {
                     bool b_val = (values[i] != 0);
                     if (ImGui::Checkbox("##chk", &b_val)) {
                         values[i] = b_val ? 1 : 0;
-                        alsa->set_control_value(c_name, 0, values);
+                        alsa->write(entry.ctl, values, count);
                     }
                     ImGui::SameLine(); ImGui::Text(b_val ? "ON" : "OFF");
                 }
@@ -752,7 +772,8 @@ void TotalMixerGUI::DrawControlTab() {
         ImGui::Text("OVR Sample Count:"); ImGui::SameLine(200);
         ImGui::SetNextItemWidth(100);
         if (ImGui::SliderInt("##ovr_cnt", &engine_.meterPrefs().ovr_sample_count, 1, 10)) {
-            ConfigManager::Save(engine_.meterPrefs(), engine_.oscPrefs());
+            engine_.ApplyMeterPrefs();
+            ConfigManager::Save(engine_.meterPrefs(), engine_.oscPrefs(), engine_.displayPrefs());
         }
         if (ImGui::IsItemHovered()) {
             ImGui::SetTooltip("Consecutive overload samples to trigger OVR indicator");
@@ -763,7 +784,8 @@ void TotalMixerGUI::DrawControlTab() {
         if (ImGui::SliderFloat("##peak_hold", &engine_.meterPrefs().peak_hold_seconds, 0.1f, 9.9f, "%.1fs")) {
             if (engine_.meterPrefs().peak_hold_seconds < 0.1f) engine_.meterPrefs().peak_hold_seconds = 0.1f;
             if (engine_.meterPrefs().peak_hold_seconds > 9.9f) engine_.meterPrefs().peak_hold_seconds = 9.9f;
-            ConfigManager::Save(engine_.meterPrefs(), engine_.oscPrefs());
+            engine_.ApplyMeterPrefs();
+            ConfigManager::Save(engine_.meterPrefs(), engine_.oscPrefs(), engine_.displayPrefs());
         }
         if (ImGui::IsItemHovered()) {
             ImGui::SetTooltip("Duration the peak indicator stays visible after signal drops");
@@ -771,7 +793,8 @@ void TotalMixerGUI::DrawControlTab() {
 
         ImGui::Text("RMS +3dB Correction:"); ImGui::SameLine(200);
         if (ImGui::Checkbox("##rms_corr", &engine_.meterPrefs().rms_plus_3db)) {
-            ConfigManager::Save(engine_.meterPrefs(), engine_.oscPrefs());
+            engine_.ApplyMeterPrefs();
+            ConfigManager::Save(engine_.meterPrefs(), engine_.oscPrefs(), engine_.displayPrefs());
         }
         ImGui::SameLine();
         ImGui::TextDisabled("?");
@@ -784,11 +807,34 @@ void TotalMixerGUI::DrawControlTab() {
         if (ImGui::SliderFloat("##rms_tau", &engine_.meterPrefs().rms_tau_seconds, 0.05f, 1.0f, "%.2fs")) {
             if (engine_.meterPrefs().rms_tau_seconds < 0.05f) engine_.meterPrefs().rms_tau_seconds = 0.05f;
             if (engine_.meterPrefs().rms_tau_seconds > 1.0f) engine_.meterPrefs().rms_tau_seconds = 1.0f;
-            ConfigManager::Save(engine_.meterPrefs(), engine_.oscPrefs());
+            engine_.ApplyMeterPrefs();
+            ConfigManager::Save(engine_.meterPrefs(), engine_.oscPrefs(), engine_.displayPrefs());
         }
         if (ImGui::IsItemHovered()) {
             ImGui::SetTooltip("RMS integration/averaging time constant (lower = faster response)");
         }
+
+        ImGui::Text("Sampling Rate:"); ImGui::SameLine(200);
+        ImGui::SetNextItemWidth(100);
+        if (ImGui::SliderInt("##sample_hz", &engine_.meterPrefs().sample_hz,
+                             MeterSampler::kMinRateHz, MeterSampler::kMaxRateHz, "%d Hz")) {
+            engine_.ApplyMeterPrefs();
+            ConfigManager::Save(engine_.meterPrefs(), engine_.oscPrefs(), engine_.displayPrefs());
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("How often the hardware meters are read, independent of the frame rate");
+        }
+
+        ImGui::Text("History Length:"); ImGui::SameLine(200);
+        ImGui::SetNextItemWidth(100);
+        if (ImGui::SliderInt("##history_s", &engine_.meterPrefs().history_seconds,
+                             MeterSampler::kMinHistorySeconds, MeterSampler::kMaxHistorySeconds, "%d s")) {
+            engine_.ApplyMeterPrefs();
+            ConfigManager::Save(engine_.meterPrefs(), engine_.oscPrefs(), engine_.displayPrefs());
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Level history kept per channel for the History tab");
+        }
     }
 
     // ── OSC Remote Section ──
@@ -828,20 +874,30 @@ void TotalMixerGUI::DrawControlTab() {
         }
         ImGui::SameLine();
         // Status line
-        if (engine_.oscRunning()) {
-            if (engine_.oscHasClient()) {
-                ImGui::TextColored(ImVec4(0.3f, 1.0f, 0.3f, 1.0f), "Running - client connected");
+        if (view_.oscRunning()) {
+            if (view_.oscHasClient()) {
+                size_t n = view_.oscClients();
+                ImGui::TextColored(ImVec4(0.3f, 1.0f, 0.3f, 1.0f), "Running - %zu client%s connected",
+                                   n, n == 1 ? "" : "s");
             } else {
                 ImGui::TextColored(ImVec4(0.9f, 0.85f, 0.4f, 1.0f), "Running - awaiting client");
             }
         } else {
             ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), "Stopped");
         }
+        if (view_.oscReceived() > 0) {
+            ImGui::TextDisabled("%llu commands received, %llu merged into later fader moves",
+                                (unsigned long long)view_.oscReceived(), (unsigned long long)view_.oscMerged());
+        }
+        if (view_.oscDropped() > 0) {
+            ImGui::TextColored(ImVec4(0.9f, 0.3f, 0.3f, 1.0f), "%llu commands dropped (receive queue full)",
+                               (unsigned long long)view_.oscDropped());
+        }
 
         ImGui::Spacing();
         ImGui::TextDisabled("Binds all interfaces (0.0.0.0). Unauthenticated UDP - use on a trusted LAN only.");
 
-        if (dirty) ConfigManager::Save(engine_.meterPrefs(), engine_.oscPrefs());
+        if (dirty) ConfigManager::Save(engine_.meterPrefs(), engine_.oscPrefs(), engine_.displayPrefs());
     }
 
     // ── Web Remote Section ──
@@ -930,49 +986,9 @@ void TotalMixerGUI::DrawControlTab() {
 
 void TotalMixerGUI::DrawMatrixTab(const char* title, bool is_playback) {
     ImGui::BeginChild(title, ImVec2(0, 0), true, ImGuiWindowFlags_HorizontalScrollbar);
-    
-    ImGuiTableFlags flags = ImGuiTableFlags_SizingFixedFit | 
-                            ImGuiTableFlags_Borders;
-    
-    if (ImGui::BeginTable("MatrixTable", 19, flags)) {
-        ImGui::TableSetupColumn("Label", ImGuiTableColumnFlags_WidthFixed, 60.0f);
-        for (int i = 0; i < 18; ++i) ImGui::TableSetupColumn(out_labels[i].c_str(), ImGuiTableColumnFlags_WidthFixed, 45.0f);
-        
-        ImGui::TableSetupScrollFreeze(1, 1);
-        
-        ImGui::TableHeadersRow();
-
-        for (int r = 0; r < 18; ++r) {
-            ImGui::TableNextRow();
-            ImGui::TableSetColumnIndex(0);
-            std::string row_label = is_playback ? "PB " + std::to_string(r+1) : in_labels[r];
-            ImGui::Text("%s", row_label.c_str());
-
-            for (int c = 0; c < 18; ++c) {
-                ImGui::TableSetColumnIndex(c + 1);
-                
-                std::string id = "##Mat" + std::to_string(r) + "_" + std::to_string(c);
-                // Bind the slider directly to the engine's cache entry so the drag stays smooth
-                // between throttled writes. The raw grid writes a single crosspoint (no link/mute).
-                long& val = engine_.crosspoint(is_playback, c, r);
-                long val_before = val;
-
-                bool changed = SquareSlider(id.c_str(), &val, 0, 65536, ImVec2(40, 40));
-
-                if (changed && val != val_before && engine_.connected() &&
-                    ShouldWrite(ImGui::GetID(id.c_str()))) {
-                    engine_.WriteCrosspointRaw(is_playback, r, c, val);
-                }
-
-                if (ImGui::IsItemActive()) {
-                    engine_.SetHeldCrosspoint(c, r);
-                } else if (engine_.isHeldCrosspoint(c, r)) {
-                    engine_.ClearHeldCrosspoint();
-                }
-            }
-        }
-        ImGui::EndTable();
-    }
+    // The raw grid writes a single crosspoint (no link/mute).
+    const MatrixSection section{is_playback, nullptr, is_playback ? &stream_labels : &in_labels};
+    DrawMatrixGrid("MatrixGrid", "Label", &section, 1);
     ImGui::EndChild();
 }
 
@@ -981,14 +997,13 @@ void TotalMixerGUI::DrawMatrixTab(const char* title, bool is_playback) {
 void TotalMixerGUI::DrawSourceStrip(bool is_playback, int src_idx, float fader_h) {
     ImGui::BeginGroup();
 
-    // Bind directly to the engine's crosspoint cache for the selected submix (smooth drag).
-    int sel = engine_.selectedOutput();
-    long& val = engine_.crosspoint(is_playback, sel, src_idx);
+    // Bind directly to the view's crosspoint for the selected submix (smooth drag).
+    int sel = view_.selectedOutput();
+    long& val = view_.crosspoint(is_playback, sel, src_idx);
     long val_before = val;
-    bool is_muted = engine_.sourceMuted(is_playback, sel, src_idx);
+    bool is_muted = view_.sourceMuted(is_playback, sel, src_idx);
 
     const std::vector<std::string>& labels = is_playback ? stream_labels : in_labels;
-    const std::vector<MeterLevel>& meters = is_playback ? stream_meters : input_meters;
     const char* label = labels[src_idx].c_str();
 
     const int min_v = 0, max_v = 65536;
@@ -1021,14 +1036,15 @@ void TotalMixerGUI::DrawSourceStrip(bool is_playback, int src_idx, float fader_h
     bool slider_active = ImGui::IsItemActive();
 
     if (slider_active) {
-        engine_.SetHeldCrosspoint(sel, src_idx);
-    } else if (engine_.isHeldCrosspoint(sel, src_idx)) {
-        engine_.ClearHeldCrosspoint();
+        view_.HoldCrosspoint(is_playback, sel, src_idx);
+    } else if (view_.isHeldCrosspoint(is_playback, sel, src_idx)) {
+        view_.ReleaseHeld();
     }
 
     ImGui::SameLine(0, gap);
-    if (src_idx < (int)meters.size()) {
-        DrawMeterBar("##mtr", meters[src_idx], ImVec2(meter_w, fader_h));
+    if (src_idx >= 0 && src_idx < 18) {
+        const MeterLevel& meter = is_playback ? view_.playbackMeter(src_idx) : view_.inputMeter(src_idx);
+        DrawMeterBar("##mtr", meter, ImVec2(meter_w, fader_h));
     }
 
     // Mouse wheel on the fader (use slider_hovered captured before the meter)
@@ -1046,19 +1062,16 @@ void TotalMixerGUI::DrawSourceStrip(bool is_playback, int src_idx, float fader_h
     }
 
     if (changed && val != val_before && engine_.connected()) {
-        ImGuiID widget_id = ImGui::GetID(id.c_str());
-        if (ShouldWrite(widget_id)) {
-            // Engine primitive: clamps, clears mute when raised, updates the cache, and mirrors
-            // the gain to the linked partner column. Raising a muted crosspoint auto-unmutes it.
-            engine_.SetSourceGain(is_playback, src_idx, sel, val);
-            is_muted = engine_.sourceMuted(is_playback, sel, src_idx);
-        }
+        // Engine primitive: clamps, clears mute when raised, updates the cache, and mirrors
+        // the gain to the linked partner column. Raising a muted crosspoint auto-unmutes it.
+        view_.SetSourceGain(is_playback, src_idx, sel, val);
+        is_muted = view_.sourceMuted(is_playback, sel, src_idx);
     }
 
-    std::string db_str = is_muted ? "MUTE" : val_to_db_str(val);
-    float db_width = ImGui::CalcTextSize(db_str.c_str()).x;
+    const char* db_str = is_muted ? "MUTE" : val_to_db_cstr(val);
+    float db_width = ImGui::CalcTextSize(db_str).x;
     ImGui::SetCursorScreenPos(ImVec2(current_x + (group_w - db_width) / 2.0f, ImGui::GetCursorScreenPos().y));
-    ImGui::TextColored(is_muted ? ImVec4(0.9f, 0.3f, 0.3f, 1.0f) : ImVec4(0, 1, 0, 1), "%s", db_str.c_str());
+    ImGui::TextColored(is_muted ? ImVec4(0.9f, 0.3f, 0.3f, 1.0f) : ImVec4(0, 1, 0, 1), "%s", db_str);
 
     // ── Mute button (per-submix crosspoint gain 0, save/restore) ──
     // Applies to the selected output and its linked partner. No dedicated hardware mute exists,
@@ -1074,7 +1087,7 @@ void TotalMixerGUI::DrawSourceStrip(bool is_playback, int src_idx, float fader_h
         std::string mute_id = "M##srcmute_" + std::string(is_playback ? "pb" : "in") + std::to_string(src_idx);
         if (ImGui::Button(mute_id.c_str(), ImVec2(mute_w, 18)) && engine_.connected()) {
             // Engine primitive: saves/restores the gain and mirrors to the linked partner.
-            engine_.SetSourceMute(is_playback, src_idx, sel, !is_muted);
+            view_.SetSourceMute(is_playback, src_idx, sel, !is_muted);
         }
         ImGui::PopStyleColor(3);
         if (ImGui::IsItemHovered()) {
@@ -1092,9 +1105,9 @@ void TotalMixerGUI::DrawMixerTab() {
     ImGui::BeginChild("MixerTab", ImVec2(0, 0), true, ImGuiWindowFlags_HorizontalScrollbar);
 
     // Submix banner
-    int sel = engine_.selectedOutput();
+    int sel = view_.selectedOutput();
     ImGui::TextColored(ImVec4(0.9f, 0.85f, 0.4f, 1.0f), "SUBMIX: %s", out_labels[sel].c_str());
-    int banner_partner = engine_.OutputLinkPartner(sel);
+    int banner_partner = view_.OutputLinkPartner(sel);
     if (banner_partner != -1) {
         ImGui::SameLine();
         ImGui::TextColored(ImVec4(0.9f, 0.85f, 0.4f, 1.0f), "+ %s (linked)", out_labels[banner_partner].c_str());
@@ -1133,7 +1146,7 @@ void TotalMixerGUI::DrawMixerTab() {
     for (int i = 0; i < 18; ++i) {
         if (i > 0) ImGui::SameLine(0, 12.0f);
         ImGui::PushID(i);
-        DrawFader(out_labels[i].c_str(), &engine_.master(i).value, 0, 65536, i);
+        DrawFader(out_labels[i].c_str(), &view_.master(i).value, 0, 65536, i);
         ImGui::PopID();
     }
 
@@ -1145,54 +1158,11 @@ void TotalMixerGUI::DrawMixerTab() {
 // write path as the Mixer View, so the two stay synchronized.
 void TotalMixerGUI::DrawCombinedMatrixTab() {
     ImGui::BeginChild("CombinedMatrix", ImVec2(0, 0), true, ImGuiWindowFlags_HorizontalScrollbar);
-
-    ImGuiTableFlags flags = ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_Borders |
-                            ImGuiTableFlags_ScrollX | ImGuiTableFlags_ScrollY;
-
-    if (ImGui::BeginTable("CombinedMatrixTable", 19, flags)) {
-        ImGui::TableSetupColumn("Src \\ Out", ImGuiTableColumnFlags_WidthFixed, 60.0f);
-        for (int i = 0; i < 18; ++i)
-            ImGui::TableSetupColumn(out_labels[i].c_str(), ImGuiTableColumnFlags_WidthFixed, 45.0f);
-        ImGui::TableSetupScrollFreeze(1, 1);
-        ImGui::TableHeadersRow();
-
-        for (int sec = 0; sec < 2; ++sec) {
-            bool is_playback = (sec == 1);
-            const std::vector<std::string>& labels = is_playback ? stream_labels : in_labels;
-
-            // Section divider row
-            ImGui::TableNextRow();
-            ImGui::TableSetColumnIndex(0);
-            ImGui::TextColored(ImVec4(0.6f, 0.8f, 1.0f, 1.0f), "%s", is_playback ? "PLAYBACK" : "INPUTS");
-
-            for (int r = 0; r < 18; ++r) {
-                ImGui::TableNextRow();
-                ImGui::TableSetColumnIndex(0);
-                ImGui::Text("%s", labels[r].c_str());
-
-                for (int c = 0; c < 18; ++c) {
-                    ImGui::TableSetColumnIndex(c + 1);
-                    std::string id = "##CM" + std::to_string(sec) + "_" + std::to_string(r) + "_" + std::to_string(c);
-                    long& val = engine_.crosspoint(is_playback, c, r);
-                    long val_before = val;
-
-                    bool changed = SquareSlider(id.c_str(), &val, 0, 65536, ImVec2(40, 40));
-
-                    if (ImGui::IsItemActive()) {
-                        engine_.SetHeldCrosspoint(c, r);
-                    } else if (engine_.isHeldCrosspoint(c, r)) {
-                        engine_.ClearHeldCrosspoint();
-                    }
-
-                    if (changed && val != val_before && engine_.connected() &&
-                        ShouldWrite(ImGui::GetID(id.c_str()))) {
-                        engine_.WriteCrosspointRaw(is_playback, r, c, val);
-                    }
-                }
-            }
-        }
-        ImGui::EndTable();
-    }
+    const MatrixSection sections[2] = {
+        {false, "INPUTS", &in_labels},
+        {true, "PLAYBACK", &stream_labels},
+    };
+    DrawMatrixGrid("CombinedMatrixGrid", "Src \\ Out", sections, 2);
     ImGui::EndChild();
 }
 
@@ -1205,7 +1175,7 @@ void TotalMixerGUI::DrawMasterSection(float height) {
     for (size_t i = 0; i < out_labels.size(); ++i) {
         if (i > 0) ImGui::SameLine(0, 15.0f); // More space between fader groups
         ImGui::PushID((int)i);
-        DrawFader(out_labels[i].c_str(), &engine_.master((int)i).value, 0, 65536, (int)i);
+        DrawFader(out_labels[i].c_str(), &view_.master((int)i).value, 0, 65536, (int)i);
         ImGui::PopID();
     }
     ImGui::EndChild();
@@ -1232,19 +1202,10 @@ void TotalMixerGUI::DrawCompactMeterStrip(const char* label, const MeterLevel& m
     DrawMeterBar("##mtr_cmp", meter, ImVec2(meter_w, height));
 
     // dB text below meter
-    float db_display = meter.normalized;
-    std::string db_str;
-    if (db_display <= 0.0f) {
-        db_str = "-inf";
-    } else {
-        float db = (db_display * 60.0f) - 60.0f;
-        char buf[16];
-        snprintf(buf, sizeof(buf), "%+.0f", db);
-        db_str = buf;
-    }
-    float db_width = ImGui::CalcTextSize(db_str.c_str()).x;
+    const char* db_str = meter_display_to_db_cstr(meter.normalized);
+    float db_width = ImGui::CalcTextSize(db_str).x;
     ImGui::SetCursorScreenPos(ImVec2(current_x + (group_w - db_width) / 2.0f, ImGui::GetCursorScreenPos().y));
-    ImGui::TextColored(ImVec4(0, 1, 0, 1), "%s", db_str.c_str());
+    ImGui::TextColored(ImVec4(0, 1, 0, 1), "%s", db_str);
 
     ImGui::EndGroup();
 }
@@ -1254,10 +1215,10 @@ void TotalMixerGUI::DrawInputSection(float height) {
     ImGui::TextColored(ImVec4(0.7f, 1.0f, 0.7f, 1.0f), "HARDWARE INPUTS");
     ImGui::Separator();
     ImGui::Spacing();
-    for (size_t i = 0; i < in_labels.size() && i < input_meters.size(); ++i) {
+    for (size_t i = 0; i < in_labels.size(); ++i) {
         if (i > 0) ImGui::SameLine(0, 15.0f);
         ImGui::PushID((int)(i + 1000));
-        DrawCompactMeterStrip(in_labels[i].c_str(), input_meters[i]);
+        DrawCompactMeterStrip(in_labels[i].c_str(), view_.inputMeter((int)i));
         ImGui::PopID();
     }
     ImGui::EndChild();
@@ -1268,15 +1229,182 @@ void TotalMixerGUI::DrawStreamSection(float height) {
     ImGui::TextColored(ImVec4(0.7f, 1.0f, 0.7f, 1.0f), "PLAYBACK STREAMS");
     ImGui::Separator();
     ImGui::Spacing();
-    for (size_t i = 0; i < stream_labels.size() && i < stream_meters.size(); ++i) {
+    for (size_t i = 0; i < stream_labels.size(); ++i) {
         if (i > 0) ImGui::SameLine(0, 15.0f);
         ImGui::PushID((int)(i + 2000));
-        DrawCompactMeterStrip(stream_labels[i].c_str(), stream_meters[i]);
+        DrawCompactMeterStrip(stream_labels[i].c_str(), view_.playbackMeter((int)i));
         ImGui::PopID();
     }
     ImGui::EndChild();
 }
 
+// ── Level history ──
+void TotalMixerGUI::DrawHistoryTab() {
+    static const char* const kGroups[] = {"Outputs", "Inputs", "Playback"};
+    static const int kGroupBase[] = {MeterBank::kOutputBase, MeterBank::kInputBase, MeterBank::kPlaybackBase};
+    const std::vector<std::string>* group_labels[] = {&out_labels, &in_labels, &stream_labels};
+
+    const MeterHistory& history = engine_.meterHistory();
+    int rate = engine_.meterPrefs().sample_hz > 0 ? engine_.meterPrefs().sample_hz : 1;
+    float max_window = (float)history.depth() / rate;
+    if (max_window < 1.0f) max_window = 1.0f;
+    history_window_s_ = ImClamp(history_window_s_, 1.0f, max_window);
+
+    ImGui::SetNextItemWidth(120);
+    ImGui::Combo("##history_group", &history_group_, kGroups, IM_ARRAYSIZE(kGroups));
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(200);
+    ImGui::SliderFloat("Window##history_window", &history_window_s_, 1.0f, max_window, "%.0f s");
+    ImGui::SameLine();
+    ImGui::TextDisabled("(history length and rate: Preferences > Level Meters)");
+    ImGui::Separator();
+
+    const float label_w = 70.0f;
+    const float row_h = 44.0f;
+    const std::vector<std::string>& labels = *group_labels[history_group_];
+    ImGui::BeginChild("HistoryRows", ImVec2(0, 0), false);
+    ImGuiListClipper clipper;
+    clipper.Begin(18, row_h + ImGui::GetStyle().ItemSpacing.y);
+    while (clipper.Step()) {
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+            ImGui::PushID(i);
+            ImGui::BeginGroup();
+            ImGui::Text("%s", i < (int)labels.size() ? labels[i].c_str() : "");
+            ImGui::EndGroup();
+            ImGui::SameLine(label_w);
+            DrawHistoryGraph("##history", kGroupBase[history_group_] + i,
+                             ImVec2(ImGui::GetContentRegionAvail().x, row_h));
+            ImGui::PopID();
+        }
+    }
+    clipper.End();
+    ImGui::EndChild();
+}
+
+// One channel: the peak range of each column as a dim bar, the RMS range over it, OVR as a red
+// tick along the top. Newest on the right; the graph scrolls with the wall clock.
+void TotalMixerGUI::DrawHistoryGraph(const char* str_id, int channel, const ImVec2& size) {
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    if (window->SkipItems) return;
+    const ImRect bb(window->DC.CursorPos, window->DC.CursorPos + size);
+    ImGui::ItemSize(bb.GetSize());
+    if (!ImGui::ItemAdd(bb, window->GetID(str_id))) return;
+
+    ImDrawList* dl = window->DrawList;
+    dl->AddRectFilled(bb.Min, bb.Max, IM_COL32(15, 15, 15, 255));
+    const ImU32 col_grid = IM_COL32(60, 60, 60, 255);
+    for (float db : {-6.0f, -20.0f, -40.0f}) {
+        float y = bb.Max.y - meter_db_to_display(db) * size.y;
+        dl->AddLine(ImVec2(bb.Min.x, y), ImVec2(bb.Max.x, y), col_grid);
+    }
+
+    const float column_w = 2.0f;
+    int columns = (int)(size.x / column_w);
+    if (columns <= 0) return;
+    if ((int)history_columns_.size() < columns) history_columns_.resize(columns);
+    auto window_len = std::chrono::duration_cast<MeterHistory::Clock::duration>(
+        std::chrono::duration<float>(history_window_s_));
+    size_t frames = engine_.meterHistory().Decimate(channel, MeterHistory::Clock::now(), window_len,
+                                                    history_columns_.data(), columns);
+    if (frames == 0) return;
+
+    const ImU32 col_ovr = IM_COL32(255, 40, 40, 255);
+    for (int c = 0; c < columns; ++c) {
+        const MeterHistory::Column& col = history_columns_[c];
+        if (col.empty || col.peak_max <= 0.0f) continue;
+        history_busy_ = true;
+        float x0 = bb.Min.x + c * column_w;
+        float x1 = x0 + column_w;
+        auto y_of = [&](float level) { return bb.Max.y - level * size.y; };
+        ImVec4 peak_col = GetMeterColor(col.peak_max);
+        peak_col.w = 0.35f;
+        dl->AddRectFilled(ImVec2(x0, y_of(col.peak_max)), ImVec2(x1, ImMin(y_of(col.peak_min), bb.Max.y - 1.0f) + 1.0f),
+                          ImGui::ColorConvertFloat4ToU32(peak_col));
+        if (col.rms_max > 0.0f) {
+            dl->AddRectFilled(ImVec2(x0, y_of(col.rms_max)), ImVec2(x1, ImMin(y_of(col.rms_min), bb.Max.y - 1.0f) + 1.0f),
+                              ImGui::ColorConvertFloat4ToU32(GetMeterColor(col.rms_max)));
+        }
+        if (col.overload) dl->AddRectFilled(bb.Min + ImVec2(c * column_w, 0.0f), ImVec2(x1, bb.Min.y + 3.0f), col_ovr);
+    }
+}
+
+// ── Overload log ──
+void TotalMixerGUI::DrawOverloadsTab() {
+    static const char* const kGroups[] = {"All Channels", "Outputs", "Inputs", "Playback"};
+    static const int kGroupBase[] = {0, MeterBank::kOutputBase, MeterBank::kInputBase, MeterBank::kPlaybackBase};
+    static const int kGroupCount[] = {MeterBank::kChannels, 18, 18, 18};
+
+    OverloadLog& log = engine_.overloadLog();
+    uint64_t revision = log.revision();
+    if (revision != overload_revision_) {
+        log.Read(overload_events_);
+        overload_revision_ = revision;
+    }
+
+    ImGui::SetNextItemWidth(140);
+    ImGui::Combo("##overload_group", &overload_group_, kGroups, IM_ARRAYSIZE(kGroups));
+    ImGui::SameLine();
+    ImGui::BeginDisabled(!log.is_open() || overload_events_.empty());
+    if (ImGui::Button("Clear Log")) log.Clear();
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    if (log.recording()) {
+        ImGui::TextDisabled("Recording to %s", log.path().c_str());
+    } else if (log.is_open()) {
+        ImGui::TextDisabled("Another totalmixer is recording to %s", log.path().c_str());
+    } else {
+        ImGui::TextDisabled("Not recording (no hardware)");
+    }
+    ImGui::Separator();
+
+    if (!log.is_open()) {
+        ImGui::TextDisabled("No overload log open.");
+        return;
+    }
+
+    const int first = kGroupBase[overload_group_];
+    const int last = first + kGroupCount[overload_group_];
+    overload_rows_.clear();
+    for (int i = (int)overload_events_.size() - 1; i >= 0; --i) {
+        int ch = overload_events_[i].channel;
+        if (ch >= first && ch < last) overload_rows_.push_back(i);
+    }
+    if (overload_rows_.empty()) {
+        ImGui::TextDisabled("No overloads recorded.");
+        return;
+    }
+
+    const ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY;
+    if (!ImGui::BeginTable("OverloadTable", 4, flags)) return;
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Start");
+    ImGui::TableSetupColumn("Channel");
+    ImGui::TableSetupColumn("Duration");
+    ImGui::TableSetupColumn("Peak");
+    ImGui::TableHeadersRow();
+    ImGuiListClipper clipper;
+    clipper.Begin((int)overload_rows_.size());
+    while (clipper.Step()) {
+        for (int r = clipper.DisplayStart; r < clipper.DisplayEnd; ++r) {
+            const OverloadEvent& ev = overload_events_[overload_rows_[r]];
+            char start[40];
+            OverloadLog::FormatStart(ev, start, sizeof(start));
+            const char* name = MeterBank::ChannelName(ev.channel);
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::Text("%s", start);
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%s", name ? name : "?");
+            ImGui::TableSetColumnIndex(2);
+            ImGui::Text("%.2f s", ev.duration_ms / 1000.0);
+            ImGui::TableSetColumnIndex(3);
+            ImGui::Text("%.1f dBFS", ev.peak_cdb / 100.0);
+        }
+    }
+    clipper.End();
+    ImGui::EndTable();
+}
+
 void TotalMixerGUI::DrawPreferencesDialog() {
     ImGui::SetNextWindowSize(ImVec2(450, 320), ImGuiCond_FirstUseEver);
     if (!ImGui::Begin("Preferences", &show_prefs_dialog, ImGuiWindowFlags_NoDocking)) {
@@ -1290,7 +1418,8 @@ void TotalMixerGUI::DrawPreferencesDialog() {
             ImGui::Text("OVR Sample Count:");
             ImGui::SetNextItemWidth(120);
             if (ImGui::SliderInt("##pref_ovr_cnt", &engine_.meterPrefs().ovr_sample_count, 1, 10)) {
-                ConfigManager::Save(engine_.meterPrefs(), engine_.oscPrefs());
+                engine_.ApplyMeterPrefs();
+                ConfigManager::Save(engine_.meterPrefs(), engine_.oscPrefs(), engine_.displayPrefs());
             }
             if (ImGui::IsItemHovered()) {
                 ImGui::SetTooltip("Consecutive overload samples to trigger OVR indicator");
@@ -1302,7 +1431,8 @@ void TotalMixerGUI::DrawPreferencesDialog() {
             if (ImGui::SliderFloat("##pref_peak_hold", &engine_.meterPrefs().peak_hold_seconds, 0.1f, 9.9f, "%.1fs")) {
                 if (engine_.meterPrefs().peak_hold_seconds < 0.1f) engine_.meterPrefs().peak_hold_seconds = 0.1f;
                 if (engine_.meterPrefs().peak_hold_seconds > 9.9f) engine_.meterPrefs().peak_hold_seconds = 9.9f;
-                ConfigManager::Save(engine_.meterPrefs(), engine_.oscPrefs());
+                engine_.ApplyMeterPrefs();
+                ConfigManager::Save(engine_.meterPrefs(), engine_.oscPrefs(), engine_.displayPrefs());
             }
             if (ImGui::IsItemHovered()) {
                 ImGui::SetTooltip("Duration the peak indicator stays visible after signal drops");
@@ -1312,7 +1442,8 @@ void TotalMixerGUI::DrawPreferencesDialog() {
             ImGui::Text("RMS +3dB Correction:");
             ImGui::SameLine();
             if (ImGui::Checkbox("##pref_rms_corr", &engine_.meterPrefs().rms_plus_3db)) {
-                ConfigManager::Save(engine_.meterPrefs(), engine_.oscPrefs());
+                engine_.ApplyMeterPrefs();
+                ConfigManager::Save(engine_.meterPrefs(), engine_.oscPrefs(), engine_.displayPrefs());
             }
             ImGui::SameLine();
             ImGui::TextDisabled("?");
@@ -1326,16 +1457,83 @@ void TotalMixerGUI::DrawPreferencesDialog() {
             if (ImGui::SliderFloat("##pref_rms_tau", &engine_.meterPrefs().rms_tau_seconds, 0.05f, 1.0f, "%.2fs")) {
                 if (engine_.meterPrefs().rms_tau_seconds < 0.05f) engine_.meterPrefs().rms_tau_seconds = 0.05f;
                 if (engine_.meterPrefs().rms_tau_seconds > 1.0f) engine_.meterPrefs().rms_tau_seconds = 1.0f;
-                ConfigManager::Save(engine_.meterPrefs(), engine_.oscPrefs());
+                engine_.ApplyMeterPrefs();
+                ConfigManager::Save(engine_.meterPrefs(), engine_.oscPrefs(), engine_.displayPrefs());
             }
             if (ImGui::IsItemHovered()) {
                 ImGui::SetTooltip("RMS integration/averaging time constant (lower = faster response)");
             }
 
+            ImGui::Spacing();
+            ImGui::Text("Sampling Rate:");
+            ImGui::SetNextItemWidth(120);
+            if (ImGui::SliderInt("##pref_sample_hz", &engine_.meterPrefs().sample_hz,
+                                 MeterSampler::kMinRateHz, MeterSampler::kMaxRateHz, "%d Hz")) {
+                engine_.ApplyMeterPrefs();
+                ConfigManager::Save(engine_.meterPrefs(), engine_.oscPrefs(), engine_.displayPrefs());
+            }
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("How often the hardware meters are read, independent of the frame rate");
+            }
+
+            ImGui::Spacing();
+            ImGui::Text("History Length:");
+            ImGui::SetNextItemWidth(120);
+            if (ImGui::SliderInt("##pref_history_s", &engine_.meterPrefs().history_seconds,
+                                 MeterSampler::kMinHistorySeconds, MeterSampler::kMaxHistorySeconds, "%d s")) {
+                engine_.ApplyMeterPrefs();
+                ConfigManager::Save(engine_.meterPrefs(), engine_.oscPrefs(), engine_.displayPrefs());
+            }
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("Level history kept per channel for the History tab");
+            }
+
+            ImGui::EndTabItem();
+        }
+        if (ImGui::BeginTabItem("Display")) {
+            ImGui::Spacing();
+            DisplayPreferences& dp = engine_.displayPrefs();
+
+            ImGui::Text("Active Frame Rate:");
+            ImGui::SetNextItemWidth(120);
+            if (ImGui::SliderInt("##pref_active_fps", &dp.active_fps, 10, 240, "%d fps")) {
+                dp.active_fps = ImClamp(dp.active_fps, 10, 240);
+                ConfigManager::Save(engine_.meterPrefs(), engine_.oscPrefs(), engine_.displayPrefs());
+            }
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("Frame cap while you interact or while meters move (vsync may cap lower)");
+            }
+
+            ImGui::Spacing();
+            ImGui::Text("Idle Frame Rate:");
+            ImGui::SetNextItemWidth(120);
+            if (ImGui::SliderInt("##pref_idle_fps", &dp.idle_fps, 0, 30, dp.idle_fps == 0 ? "on change" : "%d fps")) {
+                dp.idle_fps = ImClamp(dp.idle_fps, 0, 30);
+                ConfigManager::Save(engine_.meterPrefs(), engine_.oscPrefs(), engine_.displayPrefs());
+            }
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("Redraw rate when nothing changes; remote and hardware changes still redraw at once");
+            }
+
+            ImGui::Spacing();
+            ImGui::Text("Rendering: %.1f frames/s (%s)", fps_, frames_active_ ? "active" : "idle");
             ImGui::EndTabItem();
         }
         if (ImGui::BeginTabItem("Operation")) {
             ImGui::TextColored(ImVec4(0.5f, 0.5f, 0.5f, 1.0f), "Operation settings coming soon.");
+            ImGui::Spacing();
+
+            // Read-only view of the engine's ALSA write queue (thread-safe to query).
+            WriteQueue::Stats wq = engine_.writeStats();
+            ImGui::Text("ALSA write queue: %d Hz", engine_.writeRate());
+            ImGui::Text("Pending: %zu (peak %zu)", wq.depth, wq.max_depth);
+            ImGui::Text("Latency: %.1f ms avg, %.1f ms max", wq.avg_latency_ms, wq.max_latency_ms);
+            ImGui::Text("Edits: %llu queued, %llu coalesced into %llu row writes",
+                        (unsigned long long)wq.queued, (unsigned long long)wq.coalesced,
+                        (unsigned long long)wq.row_writes);
+            if (wq.failed > 0) {
+                ImGui::TextColored(ImVec4(0.9f, 0.3f, 0.3f, 1.0f), "Failed flushes: %llu", (unsigned long long)wq.failed);
+            }
             ImGui::EndTabItem();
         }
         if (ImGui::BeginTabItem("Snapshots")) {
@@ -1354,7 +1552,7 @@ void TotalMixerGUI::DrawPreferencesDialog() {
 void TotalMixerGUI::DrawFader(const char* label, long* value, int min_v, int max_v, int ch_idx) {
     ImGui::BeginGroup();
     
-    std::string db_str = val_to_db_str(*value);
+    const char* db_str = val_to_db_cstr(*value);
     float fader_w = 40.0f;
     float meter_w = 13.0f;        // ~1/3 of fader width
     float gap = 2.0f;
@@ -1367,14 +1565,14 @@ void TotalMixerGUI::DrawFader(const char* label, long* value, int min_v, int max
     float text_x = current_x + (group_w - label_width) / 2.0f;
     
     // Clickable label: selects this output as the submix edited by the Mixer rows 1/2.
-    bool is_selected = engine_.IsOutputSelected(ch_idx);
+    bool is_selected = view_.IsOutputSelected(ch_idx);
     ImGui::SetCursorScreenPos(ImVec2(text_x, ImGui::GetCursorScreenPos().y));
     ImVec4 label_col = is_selected ? ImVec4(1.0f, 0.9f, 0.45f, 1.0f) : ImVec4(1.0f, 1.0f, 1.0f, 1.0f);
     ImGui::PushStyleColor(ImGuiCol_Text, label_col);
     ImGui::Text("%s", label);
     ImGui::PopStyleColor();
     if (ImGui::IsItemClicked(ImGuiMouseButton_Left)) {
-        engine_.SetSubmix(ch_idx);
+        view_.SetSubmix(ch_idx);
     }
     if (ImGui::IsItemHovered()) {
         ImGui::SetTooltip("Click to edit %s submix", label);
@@ -1395,11 +1593,17 @@ void TotalMixerGUI::DrawFader(const char* label, long* value, int min_v, int max
         
         fader_changed = true;
     }
+    // Keep the dragged value on screen across snapshots until the fader is let go.
+    if (ImGui::IsItemActive()) {
+        view_.HoldMaster(ch_idx);
+    } else if (view_.isHeldMaster(ch_idx)) {
+        view_.ReleaseHeld();
+    }
 
     // Meter bar alongside the fader
     ImGui::SameLine(0, gap);
-    if (ch_idx >= 0 && ch_idx < (int)master_meters.size()) {
-        DrawMeterBar("##mtr", master_meters[ch_idx], ImVec2(meter_w, 140));
+    if (ch_idx >= 0 && ch_idx < 18) {
+        DrawMeterBar("##mtr", view_.outputMeter(ch_idx), ImVec2(meter_w, 140));
     }
 
     // Mouse Wheel Support for Master Fader (must be AFTER VSliderFloat so IsItemHovered checks the slider)
@@ -1423,10 +1627,10 @@ void TotalMixerGUI::DrawFader(const char* label, long* value, int min_v, int max
 
     // Link handling: mirror the dragged value to the partner every frame for a smooth visual
     // (the actual hardware write + persistence happens in the throttled commit below).
-    if (fader_changed && ch_idx < 18 && engine_.master(ch_idx).is_linked) {
+    if (fader_changed && ch_idx < 18 && view_.master(ch_idx).is_linked) {
         int pair_idx = (ch_idx % 2 == 0) ? ch_idx + 1 : ch_idx - 1;
         if (pair_idx >= 0 && pair_idx < 18) {
-            engine_.master(pair_idx).value = *value;
+            view_.master(pair_idx).value = *value;
         }
     }
 
@@ -1436,18 +1640,15 @@ void TotalMixerGUI::DrawFader(const char* label, long* value, int min_v, int max
     }
     
     if (ImGui::BeginPopup(popup_id.c_str())) {
-        ImGui::Text("Volume: %s -> %s", label, db_str.c_str());
+        ImGui::Text("Volume: %s -> %s", label, db_str);
         ImGui::Separator();
         
-        static std::string input_buffer;
-        if (ImGui::IsWindowAppearing()) {
-            input_buffer = val_to_db_str(*value);
-            if (!input_buffer.empty() && input_buffer[0] == '+') input_buffer = input_buffer.substr(1);
-        }
+        static char input_buffer[16];
+        if (ImGui::IsWindowAppearing()) val_to_db_buf(*value, input_buffer, sizeof(input_buffer), false);
         
         ImGui::SetNextItemWidth(120);
-        if (ImGui::InputText("##db_input_master", &input_buffer, ImGuiInputTextFlags_EnterReturnsTrue)) {
-            *value = db_str_to_val(input_buffer);
+        if (ImGui::InputText("##db_input_master", input_buffer, sizeof(input_buffer), ImGuiInputTextFlags_EnterReturnsTrue)) {
+            *value = db_cstr_to_val(input_buffer);
             fader_changed = true;
             force_write = true;
             ImGui::CloseCurrentPopup();
@@ -1462,7 +1663,7 @@ void TotalMixerGUI::DrawFader(const char* label, long* value, int min_v, int max
             char b_lab[16];
             snprintf(b_lab, sizeof(b_lab), "%+.1f", presets[i]);
             if (ImGui::Button(b_lab, ImVec2(50, 0))) {
-                *value = db_str_to_val(std::string(b_lab));
+                *value = db_cstr_to_val(b_lab);
                 fader_changed = true;
                 force_write = true;
                 ImGui::CloseCurrentPopup();
@@ -1489,7 +1690,7 @@ void TotalMixerGUI::DrawFader(const char* label, long* value, int min_v, int max
 
         // Mute button
         {
-            bool is_muted = engine_.master(ch_idx).is_muted;
+            bool is_muted = view_.master(ch_idx).is_muted;
             ImVec4 m_color = is_muted ? ImVec4(0.8f, 0.2f, 0.2f, 1.0f) : ImVec4(0.4f, 0.4f, 0.4f, 0.6f);
             ImGui::PushStyleColor(ImGuiCol_Button, m_color);
             ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(m_color.x * 1.2f, m_color.y * 1.2f, m_color.z * 1.2f, 1.0f));
@@ -1497,7 +1698,7 @@ void TotalMixerGUI::DrawFader(const char* label, long* value, int min_v, int max
 
             std::string mute_id = "M##mute_" + std::to_string(ch_idx);
             if (ImGui::Button(mute_id.c_str(), ImVec2(ms_button_w, 20))) {
-                engine_.SetMasterMute(ch_idx, !is_muted);
+                view_.SetMasterMute(ch_idx, !is_muted);
             }
             ImGui::PopStyleColor(3);
 
@@ -1510,7 +1711,7 @@ void TotalMixerGUI::DrawFader(const char* label, long* value, int min_v, int max
 
         // Solo button
         {
-            bool is_soloed = engine_.master(ch_idx).is_soloed;
+            bool is_soloed = view_.master(ch_idx).is_soloed;
             ImVec4 s_color = is_soloed ? ImVec4(0.8f, 0.8f, 0.2f, 1.0f) : ImVec4(0.4f, 0.4f, 0.4f, 0.6f);
             ImGui::PushStyleColor(ImGuiCol_Button, s_color);
             ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(s_color.x * 1.2f, s_color.y * 1.2f, s_color.z * 1.2f, 1.0f));
@@ -1518,7 +1719,7 @@ void TotalMixerGUI::DrawFader(const char* label, long* value, int min_v, int max
 
             std::string solo_id = "S##solo_" + std::to_string(ch_idx);
             if (ImGui::Button(solo_id.c_str(), ImVec2(ms_button_w, 20))) {
-                engine_.SetMasterSolo(ch_idx, !is_soloed);
+                view_.SetMasterSolo(ch_idx, !is_soloed);
             }
             ImGui::PopStyleColor(3);
 
@@ -1528,22 +1729,19 @@ void TotalMixerGUI::DrawFader(const char* label, long* value, int min_v, int max
         }
     }
     
-    // Real-time Update (throttled by ShouldWrite, unless force_write from the popup). The engine
-    // primitive clamps, clears mute, mirrors to the linked partner, and does the atomic 18-channel
-    // write with solo suppression. *value aliases engine_.master(ch_idx).value.
-    if (engine_.connected() && (fader_changed || ImGui::IsItemDeactivatedAfterEdit())) {
-        ImGuiID widget_id = ImGui::GetID(id.c_str());
-        if (force_write || ShouldWrite(widget_id)) {
-            engine_.SetMasterVolume(ch_idx, engine_.master(ch_idx).value);
-        }
+    // Real-time Update (every changed frame; the engine's write queue sets the ALSA rate). The
+    // engine primitive clamps, clears mute, mirrors to the linked partner, and does the atomic
+    // 18-channel write with solo suppression. *value aliases view_.master(ch_idx).value.
+    if (engine_.connected() && (fader_changed || force_write || ImGui::IsItemDeactivatedAfterEdit())) {
+        view_.SetMasterVolume(ch_idx, view_.master(ch_idx).value);
     }
     
-    float db_width = ImGui::CalcTextSize(db_str.c_str()).x;
+    float db_width = ImGui::CalcTextSize(db_str).x;
     ImGui::SetCursorScreenPos(ImVec2(current_x + (group_w - db_width)/2.0f, ImGui::GetCursorScreenPos().y));
-    ImGui::TextColored(ImVec4(0,1,0,1), "%s", db_str.c_str());
+    ImGui::TextColored(ImVec4(0,1,0,1), "%s", db_str);
     
     if (ch_idx < 18) {
-        bool is_linked = engine_.master(ch_idx).is_linked;
+        bool is_linked = view_.master(ch_idx).is_linked;
         int pair_idx = (ch_idx % 2 == 0) ? ch_idx + 1 : ch_idx - 1;
 
         ImVec4 link_color = is_linked ? ImVec4(0.2f, 0.8f, 1.0f, 1.0f) : ImVec4(0.5f, 0.5f, 0.5f, 0.6f);
@@ -1558,7 +1756,7 @@ void TotalMixerGUI::DrawFader(const char* label, long* value, int min_v, int max
         std::string link_btn_id = link_label + "##link_" + std::to_string(ch_idx);
 
         if (ImGui::Button(link_btn_id.c_str(), ImVec2(button_width, 20))) {
-            engine_.SetMasterLink(ch_idx, !is_linked);
+            view_.SetMasterLink(ch_idx, !is_linked);
         }
 
         ImGui::PopStyleColor(3);
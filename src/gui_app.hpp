@@ -2,12 +2,12 @@
 
 #include <vector>
 #include <string>
-#include <map>
 #include <memory>
 #include <chrono>
 #include "imgui.h" // Needed for ImVec2, ImGuiID
-#include "mixer_types.hpp" // ChannelState, MeterPreferences, OscPreferences (GUI-free)
+#include "mixer_types.hpp" // ChannelState, MeterLevel, MeterPreferences, OscPreferences (GUI-free)
 #include "mixer_engine.hpp" // MixerEngine: owns ALSA + mixer state + OSC + polling
+#include "mixer_view.hpp" // MixerView: per-frame snapshot of the engine thread's state
 #include "alsa_core.hpp"
 #include "service_checker.hpp"
 #include "bridge_process.hpp" // Optional web-remote bridge child process (GUI-managed)
@@ -23,7 +23,8 @@ enum class ConnectionStatus {
     Connected,
     ServiceNotRunning,
     ServiceFailed,
-    HardwareNotFound
+    HardwareNotFound,
+    HardwareDisconnected  // was connected; the engine lost the card
 };
 
 struct Device_Info {
@@ -33,17 +34,6 @@ struct Device_Info {
     std::string bus_speed;
 };
 
-// ── Meter Data Structures ──
-struct MeterLevel {
-    float normalized = 0.0f;       // Current level normalized to [0.0, 1.0]
-    float rms_normalized = 0.0f;   // RMS level normalized to [0.0, 1.0]
-    float peak_norm = 0.0f;        // Peak normalized value (for hold)
-    float peak_hold_time = 0.0f;   // Seconds since peak detected
-    bool is_overload = false;      // OVR flag
-    int overload_count = 0;        // Consecutive overload samples
-    float rms_sq_ema = 0.0f;       // EMA of squared linear amplitude (internal)
-};
-
 class TotalMixerGUI {
 public:
     TotalMixerGUI();
@@ -55,12 +45,27 @@ public:
 
     // Call this every frame inside the ImGui loop
     void Render();
+    // Call instead of Render() while the window is minimized: keeps the bridge child reaped
+    // and lets the engine stop polling meters nobody sees. The next Render() resumes them.
+    void RenderHidden();
+
+    // ── Frame pacing (driven by gui_main.cpp) ──
+    // The loop renders at displayPrefs().active_fps while this is true: input arrived within the
+    // last second, a widget is held, or a meter is moving. Otherwise it drops to idle_fps and
+    // draws early only for input or an engine change (which posts an empty GLFW event).
+    bool WantsActiveFrames(double now);
+    void NoteInput(double now) { last_input_time_ = now; }
+    const DisplayPreferences& displayPrefs() { return engine_.displayPrefs(); }
 
 private:
     // The GUI-free mixer core: owns the ALSA connection, mixer state, apply primitives,
-    // hardware polling, and the OSC endpoint. All mixer edits/reads go through it.
+    // hardware polling, and the OSC endpoint. It runs on its own thread once connected.
     MixerEngine engine_;
 
+    // What the widgets bind to: the engine's latest snapshot plus this frame's local edits.
+    // All mixer edits/reads go through it. Declared after engine_ (holds a reference to it).
+    MixerView view_{engine_};
+
     // GUI-side connection view (mapped from engine_.Init() / Retry results).
     ConnectionStatus connection_status;
     ServiceStatus service_status;
@@ -74,19 +79,61 @@ private:
     void DrawMasterSection(float height);
     void DrawFader(const char* label, long* value, int min_v, int max_v, int ch_idx);
     void DrawSourceStrip(bool is_playback, int src_idx, float fader_h);
-    bool SquareSlider(const char* label, long* value, int min_v, int max_v, const ImVec2& size);
 
-    // Meter Methods (display-only; poll the hardware through engine_.alsa()).
-    void PollMeters();
+    // Crosspoint grid widget (DrawMatrixGrid in gui_app.cpp). A section is one matrix (inputs or
+    // playback) as 18 source rows under an optional divider title.
+    struct MatrixSection {
+        bool is_playback;
+        const char* title;                        // divider row label, or nullptr for none
+        const std::vector<std::string>* labels;   // 18 source row labels
+    };
+    struct MatrixCell {
+        bool is_playback = false;
+        int out = 0;
+        int src = 0;
+    };
+    void DrawMatrixGrid(const char* str_id, const char* corner_label,
+                        const MatrixSection* sections, int section_count);
+    MatrixCell matrix_drag_;        // cell under the active drag
+    ImGuiID matrix_drag_id_ = 0;    // grid that owns matrix_drag_ (0 = none)
+    MatrixCell matrix_popup_;       // cell the right-click popup edits
+
+    // Meter Methods (display-only; levels come from the engine snapshot).
     void DrawMeterBar(const char* label, const MeterLevel& meter, const ImVec2& size);
     void DrawCompactMeterStrip(const char* label, const MeterLevel& meter, float height = 90.0f);
     void DrawInputSection(float height);
     void DrawStreamSection(float height);
 
+    // Level history tab: one scrolling graph per channel of the chosen group, min/max-decimated
+    // to the graph width from the engine's MeterHistory.
+    void DrawHistoryTab();
+    void DrawHistoryGraph(const char* str_id, int channel, const ImVec2& size);
+    int history_group_ = 0;                              // 0 = outputs, 1 = inputs, 2 = playback
+    float history_window_s_ = 10.0f;                     // seconds shown
+    std::vector<MeterHistory::Column> history_columns_;  // reused per graph
+    bool history_busy_ = false;                          // a drawn graph still shows signal
+
+    // Overloads tab: the engine's persistent overload log, newest first, filtered by group.
+    void DrawOverloadsTab();
+    int overload_group_ = 0;                           // 0 = all, 1 = outputs, 2 = inputs, 3 = playback
+    uint64_t overload_revision_ = ~0ull;               // log revision overload_events_ was read at
+    std::vector<OverloadEvent> overload_events_;       // oldest first
+    std::vector<int> overload_rows_;                   // indices into overload_events_, newest first
+
     // Preferences
     void DrawPreferencesDialog();
     bool show_prefs_dialog = false;
 
+    // Frame pacing state (glfwGetTime() seconds) and the frames-per-second readout, counted
+    // over one-second windows of Render() calls.
+    bool MetersMoving() const;
+    double last_input_time_ = 0.0;
+    bool frames_active_ = true;
+    bool hidden_ = false;
+    int fps_frames_ = 0;
+    std::chrono::steady_clock::time_point fps_window_start_ = std::chrono::steady_clock::now();
+    float fps_ = 0.0f;
+
     // Optional web-remote bridge, launched as a child process from the Web Remote section.
     // Reaped once per frame in Render() so an exited child never lingers as a zombie.
     BridgeProcess bridge_;
@@ -95,18 +142,18 @@ private:
     // Data / State
     std::vector<std::string> out_labels;
     std::vector<std::string> in_labels;
-    Device_Info device_info;
-
-    // Meter State
-    std::vector<MeterLevel> master_meters;   // 18 channels, indexed by master ch_idx
-    std::vector<MeterLevel> input_meters;    // 18 channels, hardware inputs
-    std::vector<MeterLevel> stream_meters;   // 18 channels, playback streams
     std::vector<std::string> stream_labels;  // Labels for playback streams
-    std::chrono::steady_clock::time_point last_meter_poll_time;
+    Device_Info device_info;
 
-    // Safety: per-widget input throttle (GUI-only; the actual hardware write lives in the engine).
-    std::map<ImGuiID, std::chrono::steady_clock::time_point> last_widget_write_time;
-    bool ShouldWrite(ImGuiID id);
+    // Control tab elements in draw order, resolved once per connection (handle + enum item
+    // names for Combo). An unresolvable control keeps an invalid handle and is skipped.
+    struct ControlTabEntry {
+        ControlHandle ctl;
+        std::vector<std::string> enum_items;
+        std::vector<const char*> enum_item_ptrs;  // points into enum_items
+    };
+    std::vector<ControlTabEntry> control_tab_entries;
+    bool control_tab_resolved = false;
 };
 
 } // namespace TotalMixer
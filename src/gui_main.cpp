@@ -2,6 +2,7 @@
 // (GLFW is a cross-platform general purpose library for handling windows, inputs, OpenGL/Vulkan/Metal graphics context creation, etc.)
 
 #include "imgui.h"
+#include "imgui_internal.h" // InputEventsQueue: did this wakeup bring input?
 #include "imgui_impl_glfw.h"
 #include "imgui_impl_opengl3.h"
 #include <stdio.h>
@@ -79,8 +80,32 @@ int main(int, char**) {
     TotalMixer::TotalMixerGUI app;
 
     // 4. Main Loop
+    // Frames are paced instead of drawn back to back: at the active rate while the app asks for
+    // it (input, a held widget, moving meters), otherwise blocked in glfwWaitEventsTimeout until
+    // input, an engine change (glfwPostEmptyEvent) or the idle redraw. Minimized, nothing is drawn.
+    double last_frame = 0.0;
     while (!glfwWindowShouldClose(window)) {
-        glfwPollEvents();
+        if (glfwGetWindowAttrib(window, GLFW_ICONIFIED)) {
+            app.RenderHidden();
+            glfwWaitEventsTimeout(1.0);
+            continue;
+        }
+        const TotalMixer::DisplayPreferences& display = app.displayPrefs();
+        double now = glfwGetTime();
+        if (app.WantsActiveFrames(now)) {
+            // Hold the cap even when input arrives sooner; it queues up for the frame.
+            double deadline = last_frame + 1.0 / (display.active_fps > 0 ? display.active_fps : 60);
+            while ((now = glfwGetTime()) < deadline) glfwWaitEventsTimeout(deadline - now);
+            glfwPollEvents();
+        } else if (display.idle_fps > 0) {
+            double deadline = last_frame + 1.0 / display.idle_fps;
+            if (now < deadline) glfwWaitEventsTimeout(deadline - now);
+            else glfwPollEvents();
+        } else {
+            glfwWaitEvents();
+        }
+        last_frame = glfwGetTime();
+        if (ImGui::GetCurrentContext()->InputEventsQueue.Size > 0) app.NoteInput(last_frame);
 
         // Start Frame
         ImGui_ImplOpenGL3_NewFrame();
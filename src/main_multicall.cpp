@@ -4,6 +4,8 @@
 //
 //   totalmixer daemon [--osc-in P] [--osc-out P] [--card N]   headless OSC daemon
 //   totalmixer info   [--card N]                              dump ALSA controls
+//   totalmixer bench  [--latency-us N] [--iterations N]       engine benchmarks (simulated card)
+//   totalmixer overloads [--channel NAME] [--last N]          list recorded overloads
 //   totalmixer --help                                         this message
 //
 // Each subcommand receives the argv slice starting at its own name (argv + 1), so option
@@ -26,6 +28,8 @@ void PrintUsage() {
         "Commands:\n"
         "  daemon    Run the headless OSC control daemon\n"
         "  info      Dump the card's ALSA controls for diagnostics\n"
+        "  bench     Benchmark the engine against a simulated Fireface\n"
+        "  overloads List the recorded overloads (which channel clipped when)\n"
         "\n"
         "Run 'totalmixer <command> --help' for command-specific options.\n";
 }
@@ -52,6 +56,12 @@ int main(int argc, char** argv) {
     if (std::strcmp(command, "info") == 0) {
         return TotalMixer::RunInfo(argc - 1, argv + 1);
     }
+    if (std::strcmp(command, "bench") == 0) {
+        return TotalMixer::RunBench(argc - 1, argv + 1);
+    }
+    if (std::strcmp(command, "overloads") == 0) {
+        return TotalMixer::RunOverloads(argc - 1, argv + 1);
+    }
 
     std::cerr << "Error: unknown command '" << command << "'\n\n";
     PrintUsage();
@@ -0,0 +1,147 @@
+#include "meter_ballistics.hpp"
+#include "db_tables.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace TotalMixer {
+
+// Peak-hold line fall rate (display units per second) after the hold time expires.
+static constexpr float kPeakDecayPerSec = 0.30f;
+// Overload: instantaneous level at/above ~-0.5 dBFS (near digital full scale).
+static constexpr float kOvrDisplay = meter_db_to_display(-0.5f);
+
+// log2 without libm, so loops calling it vectorize: exponent from the float bits, plus an
+// atanh series for the mantissa m in [1, 2) (t = (m-1)/(m+1) <= 1/3; the first omitted term
+// is below 2e-5). Zero and denormals come out at or below -126, far under the meter floor.
+static inline float FastLog2(float x) {
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    float exponent = static_cast<float>(static_cast<int32_t>(bits >> 23) - 127);
+    bits = (bits & 0x007FFFFFu) | 0x3F800000u;
+    float m;
+    std::memcpy(&m, &bits, sizeof(m));
+    float t = (m - 1.0f) / (m + 1.0f);
+    float t2 = t * t;
+    float series = t * (1.0f + t2 * (1.0f / 3.0f + t2 * (1.0f / 5.0f + t2 * (1.0f / 7.0f))));
+    return exponent + 2.8853900817779268f * series;  // 2 / ln 2
+}
+
+// dB = kDbPerOctave * log2(amplitude) (20*log10(2)); applied to a squared amplitude, halve it.
+static constexpr float kDbPerOctave = 6.0205999f;
+
+// By value and without std::clamp's references, so it stays a min/max and not a branch
+// (meter_db_to_display in db_tables.hpp, in the form the vectorizer takes).
+static inline float Clamp01(float v) {
+    v = v > 0.0f ? v : 0.0f;
+    return v < 1.0f ? v : 1.0f;
+}
+
+static inline float DbToDisplay(float db) {
+    return Clamp01((db + kMeterFloorDb) * (1.0f / kMeterFloorDb));
+}
+
+MeterBallistics::MeterBallistics() {
+    Reset();
+}
+
+void MeterBallistics::Reset() {
+    std::memset(raw_, 0, sizeof(raw_));
+    std::fill(std::begin(raw_min_), std::end(raw_min_), 0.0f);
+    std::fill(std::begin(raw_scale_), std::end(raw_scale_), 0.0f);
+    std::fill(std::begin(live_), std::end(live_), 0.0f);
+    std::fill(std::begin(norm_), std::end(norm_), 0.0f);
+    std::fill(std::begin(inst_), std::end(inst_), 0.0f);
+    std::fill(std::begin(rms_sq_), std::end(rms_sq_), 0.0f);
+    std::fill(std::begin(rms_), std::end(rms_), 0.0f);
+    std::fill(std::begin(peak_), std::end(peak_), 0.0f);
+    std::fill(std::begin(hold_), std::end(hold_), 0.0f);
+    std::fill(std::begin(ovr_count_), std::end(ovr_count_), 0);
+    std::fill(std::begin(ovr_), std::end(ovr_), 0);
+}
+
+void MeterBallistics::SetRange(int lane, int count, long raw_min, long raw_max) {
+    long range = raw_max - raw_min;
+    if (range <= 0) range = 1;
+    for (int i = lane; i < lane + count && i < kLanes; ++i) {
+        raw_min_[i] = static_cast<float>(raw_min);
+        raw_scale_[i] = 1.0f / static_cast<float>(range);
+    }
+}
+
+void MeterBallistics::SetLive(int lane, int count, bool live) {
+    for (int i = lane; i < lane + count && i < kLanes; ++i) live_[i] = live ? 1.0f : 0.0f;
+}
+
+void MeterBallistics::Advance(float dt, const MeterPreferences& prefs) {
+    const float rms_alpha = 1.0f - expf(-dt / prefs.rms_tau_seconds);
+    // +3dB correction is added in the dB domain (same as scaling the amplitude by 10^(3/20)).
+    const float rms_offset_db = prefs.rms_plus_3db ? 3.0f : 0.0f;
+    const float hold_seconds = prefs.peak_hold_seconds;
+    const float decay = kPeakDecayPerSec * dt;
+    const int32_t ovr_samples = prefs.ovr_sample_count;
+
+    // Lanes that are not live keep their old value through keep() (live_ is 1 or 0: a blend
+    // rather than a conditional store, which the vectorizer would refuse).
+    auto keep = [](float live, float next, float old) { return next * live + old * (1.0f - live); };
+
+    // Normalize the raw value to [0, 1] linear amplitude.
+    for (int i = 0; i < kLanes; ++i) {
+        float n = Clamp01((static_cast<float>(raw_[i]) - raw_min_[i]) * raw_scale_[i]);
+        norm_[i] = keep(live_[i], n, norm_[i]);
+    }
+
+    // Instantaneous level (drives the peak follower and overload detection).
+    for (int i = 0; i < kLanes; ++i) {
+        float d = DbToDisplay(kDbPerOctave * FastLog2(norm_[i]));
+        inst_[i] = keep(live_[i], d, inst_[i]);
+    }
+
+    // RMS: EMA of the squared amplitude (the filled bar body), mapped without a square root.
+    for (int i = 0; i < kLanes; ++i) {
+        float n = norm_[i];
+        float sq = rms_sq_[i] + rms_alpha * (n * n - rms_sq_[i]);
+        rms_sq_[i] = keep(live_[i], sq, rms_sq_[i]);
+    }
+    for (int i = 0; i < kLanes; ++i) {
+        float d = DbToDisplay(0.5f * kDbPerOctave * FastLog2(rms_sq_[i]) + rms_offset_db);
+        rms_[i] = keep(live_[i], d, rms_[i]);
+    }
+
+    // Peak follower: instant attack, hold for peak_hold_seconds, then slow decay toward the
+    // instantaneous level. The decay pass reads the hold time the attack pass just advanced.
+    for (int i = 0; i < kLanes; ++i) {
+        // Reset by multiplying with 0 rather than selecting 0, which the compiler would sink
+        // into a branch.
+        float still = static_cast<float>((inst_[i] < peak_[i]) | (live_[i] == 0.0f));
+        hold_[i] = (hold_[i] + dt * live_[i]) * still;
+    }
+    for (int i = 0; i < kLanes; ++i) {
+        float inst = inst_[i];
+        float peak = peak_[i];
+        float decayed = peak - decay;
+        decayed = decayed > inst ? decayed : inst;
+        float next = hold_[i] >= hold_seconds ? decayed : peak;
+        next = inst >= peak ? inst : next;
+        peak_[i] = keep(live_[i], next, peak);
+    }
+
+    // OVR: enough consecutive samples in the overload zone.
+    for (int i = 0; i < kLanes; ++i) {
+        int32_t live = -static_cast<int32_t>(live_[i]);  // all ones or zero
+        int32_t count = inst_[i] >= kOvrDisplay ? ovr_count_[i] + 1 : 0;
+        ovr_count_[i] = (count & live) | (ovr_count_[i] & ~live);
+        ovr_[i] = ovr_count_[i] >= ovr_samples;
+    }
+}
+
+void MeterBallistics::Store(MeterLevel* out, int count) const {
+    for (int i = 0; i < count && i < kLanes; ++i) {
+        out[i].normalized = inst_[i];
+        out[i].rms_normalized = rms_[i];
+        out[i].peak_norm = peak_[i];
+        out[i].is_overload = ovr_[i] != 0;
+    }
+}
+
+} // namespace TotalMixer
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include "mixer_types.hpp"
+
+namespace TotalMixer {
+
+// Meter display ballistics over every channel at once, laid out structure-of-arrays: each stage
+// (normalize, level to display scale, RMS EMA, peak follower, OVR counter) is one branch-free
+// pass over all lanes, so the compiler vectorizes it. The dB mapping uses a polynomial log2
+// (error well under 0.001 dB) instead of log10f, and RMS is mapped from the squared EMA directly
+// (10*log10), so no pass calls into libm.
+//
+// The passes are plain loops kept free of branches and conditional stores, which GCC (12+, -O2)
+// and Clang vectorize for the baseline ISA; check with -fopt-info-vec when touching them.
+// Lanes are channels in MeterBank order, padded to a multiple of 8. A lane that is not live this
+// frame (its control could not be read) keeps its state. Not thread-safe; MeterBank owns one.
+class MeterBallistics {
+public:
+    static constexpr int kLanes = 56;
+
+    MeterBallistics();
+
+    // Zero all state, inputs and ranges (every lane dead until SetRange()).
+    void Reset();
+
+    // Raw control range of lanes [lane, lane + count).
+    void SetRange(int lane, int count, long raw_min, long raw_max);
+
+    // Inputs for the next Advance(): raw control values and which lanes were read this frame.
+    long* raw() { return raw_; }
+    void SetLive(int lane, int count, bool live);
+
+    // Run one frame of ballistics, dt seconds after the previous one.
+    void Advance(float dt, const MeterPreferences& prefs);
+
+    // Copy the display state of the first count lanes out.
+    void Store(MeterLevel* out, int count) const;
+
+private:
+    alignas(32) long raw_[kLanes];
+    alignas(32) float raw_min_[kLanes];
+    alignas(32) float raw_scale_[kLanes];  // 1 / (max - min)
+    alignas(32) float live_[kLanes];       // 1 = read this frame, 0 = keep state
+
+    alignas(32) float norm_[kLanes];       // instantaneous linear amplitude
+    alignas(32) float inst_[kLanes];       // instantaneous display level
+    alignas(32) float rms_sq_[kLanes];     // EMA of squared amplitude
+    alignas(32) float rms_[kLanes];        // RMS display level
+    alignas(32) float peak_[kLanes];       // peak-hold display level
+    alignas(32) float hold_[kLanes];       // seconds since the peak was set
+    alignas(32) int32_t ovr_count_[kLanes];
+    alignas(32) int32_t ovr_[kLanes];
+};
+
+} // namespace TotalMixer
@@ -0,0 +1,117 @@
+#include "meter_bank.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace TotalMixer {
+
+MeterBank::MeterBank()
+    : sources_{{
+          // Outputs: ch 0-7 = analog-out, 8-9 = spdif-out, 10-17 = adat-out
+          {"meter:analog-output", kOutputBase + 0, 8, {}},
+          {"meter:spdif-output",  kOutputBase + 8, 2, {}},
+          {"meter:adat-output",   kOutputBase + 10, 8, {}},
+          // Inputs: ch 0-7 = analog-in, 8-9 = spdif-in, 10-17 = adat-in
+          {"meter:analog-input",  kInputBase + 0, 8, {}},
+          {"meter:spdif-input",   kInputBase + 8, 2, {}},
+          {"meter:adat-input",    kInputBase + 10, 8, {}},
+          // Playback: ch 0-17 = stream-input
+          {"meter:stream-input",  kPlaybackBase, 18, {}},
+      }},
+      last_poll_(std::chrono::steady_clock::now()) {}
+
+void MeterBank::Reset() {
+    resolved_ = false;
+    for (Source& src : sources_) src.ctl = ControlHandle{};
+    ballistics_.Reset();
+    levels_.fill(MeterLevel{});
+}
+
+void MeterBank::SetPrefs(const MeterPreferences& prefs) {
+    std::lock_guard<std::mutex> lock(prefs_mtx_);
+    prefs_ = prefs;
+}
+
+// Resolve the meter controls once per connection (the handle carries the raw value range).
+void MeterBank::Resolve(AlsaBackend& alsa) {
+    // Enable hardware metering. The daemon only (re)starts its meter timer on a 0->1 transition
+    // of this control; if it was left at 1 from a previous session, writing 1 again is a no-op
+    // and meters stay frozen. Force the edge with 0 then 1.
+    auto metering = alsa.resolve("metering", 0);
+    if (metering && alsa.write(*metering, 0L) && alsa.write(*metering, 1L)) {
+        std::cout << "[METER] Hardware metering enabled (forced 0->1 edge)" << std::endl;
+    } else {
+        std::cerr << "[METER] Warning: failed to enable metering" << std::endl;
+    }
+
+    for (Source& src : sources_) {
+        auto h = alsa.resolve(src.name, 0);
+        src.ctl = h ? *h : ControlHandle{};
+        if (h) {
+            ballistics_.SetRange(src.base, src.count, h->min, h->max);
+            std::cout << "[METER] " << src.name << " raw range: "
+                      << h->min << " .. " << h->max << std::endl;
+        }
+    }
+    resolved_ = true;
+}
+
+bool MeterBank::Poll(AlsaBackend& alsa, std::chrono::steady_clock::time_point now) {
+    MeterPreferences prefs;
+    {
+        std::lock_guard<std::mutex> lock(prefs_mtx_);
+        prefs = prefs_;
+    }
+
+    bool any = false;
+    try {
+        if (!resolved_) Resolve(alsa);
+
+        // Delta time for the RMS integration and the peak hold decay.
+        float dt = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_poll_).count() / 1000.0f;
+        if (dt < 0.001f) dt = 0.1f;
+        last_poll_ = now;
+
+        // Gather every source into its lanes, then advance all channels in one pass.
+        for (const Source& src : sources_) {
+            long raw[18];
+            bool live = src.ctl.valid() && alsa.read(src.ctl, raw, 18) >= src.count;
+            ballistics_.SetLive(src.base, src.count, live);
+            if (!live) continue;
+            any = true;
+            std::copy(raw, raw + src.count, ballistics_.raw() + src.base);
+        }
+        if (any) {
+            ballistics_.Advance(dt, prefs);
+            ballistics_.Store(levels_.data(), kChannels);
+        }
+    } catch (...) {}
+    return any;
+}
+
+void MeterBank::EncodeLevels(const std::array<MeterLevel, kChannels>& levels, uint8_t* out) {
+    auto to_byte = [](float v) { return static_cast<uint8_t>(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f); };
+    for (int i = 0; i < kChannels; ++i) {
+        out[i] = to_byte(levels[i].rms_normalized);
+        out[kChannels + i] = to_byte(levels[i].peak_norm);
+        out[2 * kChannels + i] = levels[i].is_overload ? 1 : 0;
+    }
+}
+
+const char* MeterBank::ChannelName(int ch) {
+    static const char* const kNames[kChannels] = {
+        "Out Line 1", "Out Line 2", "Out Line 3", "Out Line 4", "Out Line 5", "Out Line 6",
+        "Out Phones L", "Out Phones R", "Out SPDIF L", "Out SPDIF R",
+        "Out ADAT 1", "Out ADAT 2", "Out ADAT 3", "Out ADAT 4",
+        "Out ADAT 5", "Out ADAT 6", "Out ADAT 7", "Out ADAT 8",
+        "In 1", "In 2", "In 3", "In 4", "In 5", "In 6", "In 7", "In 8",
+        "In SPDIF L", "In SPDIF R",
+        "In ADAT 1", "In ADAT 2", "In ADAT 3", "In ADAT 4",
+        "In ADAT 5", "In ADAT 6", "In ADAT 7", "In ADAT 8",
+        "PB 1", "PB 2", "PB 3", "PB 4", "PB 5", "PB 6",
+        "PB 7", "PB 8", "PB 9", "PB 10", "PB 11", "PB 12",
+        "PB 13", "PB 14", "PB 15", "PB 16", "PB 17", "PB 18",
+    };
+    return ch >= 0 && ch < kChannels ? kNames[ch] : nullptr;
+}
+
+} // namespace TotalMixer
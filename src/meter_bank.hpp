@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include "alsa_backend.hpp"
+#include "meter_ballistics.hpp"
+#include "mixer_types.hpp"
+
+namespace TotalMixer {
+
+// Hardware level meters: reads the meter:* controls and runs the display ballistics (RMS
+// integration, peak hold with decay, OVR detection) for all 54 channels in one MeterBallistics
+// pass. GUI-free, so the engine can meter for the GUI and for remote OSC clients alike.
+//
+// Poll() belongs to one thread (the MeterSampler's); SetPrefs() may be called from any thread.
+class MeterBank {
+public:
+    // Channel layout of levels(): outputs 1-18, hardware inputs 1-18, playback streams 1-18.
+    static constexpr int kChannels = 54;
+    static constexpr int kOutputBase = 0;
+    static constexpr int kInputBase = 18;
+    static constexpr int kPlaybackBase = 36;
+    // Size of the EncodeLevels() blob: one byte of RMS, one of peak, one of OVR per channel.
+    static constexpr size_t kBlobBytes = 3 * kChannels;
+    static_assert(kChannels <= MeterBallistics::kLanes, "every channel needs a ballistics lane");
+
+    MeterBank();
+
+    // Forget the resolved controls and levels (new connection). The next Poll() resolves the
+    // meter controls again and forces metering on.
+    void Reset();
+
+    // Ballistics tuning; takes effect from the next Poll().
+    void SetPrefs(const MeterPreferences& prefs);
+
+    // Read every meter control once and advance the ballistics to now. Returns false if nothing
+    // could be read.
+    bool Poll(AlsaBackend& alsa, std::chrono::steady_clock::time_point now);
+
+    const std::array<MeterLevel, kChannels>& levels() const { return levels_; }
+
+    // Pack levels for the wire: kChannels bytes of RMS display level (0-255), then kChannels of
+    // peak-hold level, then kChannels of OVR flags (0/1), each in levels() order.
+    static void EncodeLevels(const std::array<MeterLevel, kChannels>& levels, uint8_t* out);
+
+    // Display name of a channel, e.g. "Out Line 1", "In SPDIF L", "PB 7" (nullptr if out of range).
+    static const char* ChannelName(int ch);
+
+private:
+    struct Source {
+        const char* name;
+        int base;   // first channel in levels_
+        int count;
+        ControlHandle ctl;
+    };
+
+    std::array<Source, 7> sources_;
+    bool resolved_ = false;
+    MeterBallistics ballistics_;
+    std::array<MeterLevel, kChannels> levels_{};
+    std::chrono::steady_clock::time_point last_poll_;
+
+    mutable std::mutex prefs_mtx_;
+    MeterPreferences prefs_;
+
+    void Resolve(AlsaBackend& alsa);
+};
+
+} // namespace TotalMixer
@@ -0,0 +1,180 @@
+#include "meter_history.hpp"
+#include <algorithm>
+
+namespace TotalMixer {
+
+static inline uint8_t ToByte(float v) {
+    return static_cast<uint8_t>(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+void MeterHistory::Resize(size_t frames) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    Level& raw = levels_[0];
+    if (frames == raw.depth) return;
+
+    // Carry over the newest frames that fit, oldest first, so a rate change does not blank the
+    // graphs. The bucket levels are rebuilt from them.
+    size_t keep = static_cast<size_t>(std::min<uint64_t>(raw.count, std::min(raw.depth, frames)));
+    std::vector<Clock::time_point> times(keep);
+    std::vector<Cell> cells(keep * kChannels);  // frame-major, as AppendLocked() takes them
+    for (size_t i = 0; i < keep; ++i) {
+        size_t from = static_cast<size_t>((raw.count - keep + i) % raw.depth);
+        times[i] = raw.times[from];
+        for (int ch = 0; ch < kChannels; ++ch) cells[i * kChannels + ch] = raw.cells[ch * raw.depth + from];
+    }
+
+    size_t span = 1;
+    for (Level& level : levels_) {
+        level.depth = frames == 0 ? 0 : (frames + span - 1) / span;
+        level.times.assign(level.depth, Clock::time_point{});
+        level.cells.assign(level.depth * kChannels, Cell{});
+        span *= kFanout;
+    }
+    ResetLocked();
+    for (size_t i = 0; i < keep; ++i) AppendLocked(times[i], &cells[i * kChannels]);
+}
+
+size_t MeterHistory::depth() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return levels_[0].depth;
+}
+
+void MeterHistory::Append(Clock::time_point time, const std::array<MeterLevel, kChannels>& levels) {
+    std::array<Cell, kChannels> frame;
+    for (int ch = 0; ch < kChannels; ++ch) {
+        uint8_t peak = ToByte(levels[ch].peak_norm);
+        uint8_t rms = ToByte(levels[ch].rms_normalized);
+        frame[ch] = Cell{peak, peak, rms, rms, static_cast<uint8_t>(levels[ch].is_overload ? 1 : 0)};
+    }
+    std::lock_guard<std::mutex> lock(mtx_);
+    AppendLocked(time, frame.data());
+}
+
+// Stores the frame at level 0 and widens every level's open bucket by it; a bucket that has
+// collected its kFanout^level frames is stored as that level's newest entry.
+void MeterHistory::AppendLocked(Clock::time_point time, const Cell* frame) {
+    if (levels_[0].depth == 0) return;
+    int span = 1;
+    for (int l = 0; l < kLevels; ++l, span *= kFanout) {
+        Level& level = levels_[l];
+        const Cell* entry = frame;
+        if (l > 0) {
+            for (int ch = 0; ch < kChannels; ++ch) {
+                Cell& open = level.open[ch];
+                const Cell& c = frame[ch];
+                if (level.open_frames == 0) {
+                    open = c;
+                } else {
+                    open.peak_min = std::min(open.peak_min, c.peak_min);
+                    open.peak_max = std::max(open.peak_max, c.peak_max);
+                    open.rms_min = std::min(open.rms_min, c.rms_min);
+                    open.rms_max = std::max(open.rms_max, c.rms_max);
+                    open.overload |= c.overload;
+                }
+            }
+            if (++level.open_frames < span) continue;
+            level.open_frames = 0;
+            entry = level.open.data();
+        }
+        size_t slot = static_cast<size_t>(level.count % level.depth);
+        level.times[slot] = time;
+        for (int ch = 0; ch < kChannels; ++ch) level.cells[ch * level.depth + slot] = entry[ch];
+        ++level.count;
+    }
+}
+
+void MeterHistory::Clear() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    ResetLocked();
+}
+
+void MeterHistory::ResetLocked() {
+    for (Level& level : levels_) {
+        level.count = 0;
+        level.open_frames = 0;
+    }
+}
+
+// Picks the coarsest level whose entries are at most half a column apart (a bucket lands whole
+// in the column of its newest frame, so this bounds how far it smears into the next column),
+// then walks it back from the newest entry until one falls before the window; each entry lands
+// in the column its timestamp maps to, widening that column's min/max. Frames newer than that
+// level's newest bucket (its open bucket) are taken from level 0 first.
+size_t MeterHistory::Decimate(int ch, Clock::time_point end, Clock::duration window, Column* out,
+                              int columns) const {
+    for (int c = 0; c < columns; ++c) out[c] = Column{};
+    if (ch < 0 || ch >= kChannels || columns <= 0 || window.count() <= 0) return 0;
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (levels_[0].depth == 0) return 0;
+    const Clock::time_point start = end - window;
+    const double per_column = static_cast<double>(window.count()) / columns;
+
+    auto available = [](const Level& level) {
+        return static_cast<size_t>(std::min<uint64_t>(level.count, level.depth));
+    };
+    auto time_at = [](const Level& level, size_t back) {  // back = 1 is the newest entry
+        return level.times[static_cast<size_t>((level.count - back) % level.depth)];
+    };
+
+    int use = 0;
+    size_t span = 1;
+    for (int l = kLevels - 1; l > 0; --l) {
+        const Level& level = levels_[l];
+        size_t n = available(level);
+        if (n < 2) continue;
+        double spacing = static_cast<double>((time_at(level, 1) - time_at(level, n)).count()) / (n - 1);
+        if (spacing * 2.0 <= per_column) {
+            use = l;
+            for (int i = 0; i < l; ++i) span *= kFanout;
+            break;
+        }
+    }
+
+    size_t scanned = 0;
+    auto fold = [&](const Level& level, size_t back, size_t frames) {
+        size_t slot = static_cast<size_t>((level.count - back) % level.depth);
+        Clock::time_point t = level.times[slot];
+        if (t > end) return;
+        int c = static_cast<int>((t - start).count() / per_column);
+        if (c >= columns) c = columns - 1;
+        Column& col = out[c];
+        const Cell& cell = level.cells[ch * level.depth + slot];
+        float p_min = cell.peak_min * (1.0f / 255.0f), p_max = cell.peak_max * (1.0f / 255.0f);
+        float r_min = cell.rms_min * (1.0f / 255.0f), r_max = cell.rms_max * (1.0f / 255.0f);
+        if (col.empty) {
+            col.peak_min = p_min;
+            col.peak_max = p_max;
+            col.rms_min = r_min;
+            col.rms_max = r_max;
+            col.empty = false;
+        } else {
+            col.peak_min = std::min(col.peak_min, p_min);
+            col.peak_max = std::max(col.peak_max, p_max);
+            col.rms_min = std::min(col.rms_min, r_min);
+            col.rms_max = std::max(col.rms_max, r_max);
+        }
+        col.overload = col.overload || cell.overload != 0;
+        scanned += frames;
+    };
+
+    const Level& raw = levels_[0];
+    const Level& level = levels_[use];
+    size_t n = available(level);
+    Clock::time_point covered = n > 0 ? time_at(level, 1) : Clock::time_point::min();
+    if (use > 0) {
+        size_t raw_n = available(raw);
+        for (size_t back = 1; back <= raw_n; ++back) {
+            Clock::time_point t = time_at(raw, back);
+            if (t <= covered || t <= start) break;
+            fold(raw, back, 1);
+        }
+    }
+    for (size_t back = 1; back <= n; ++back) {
+        if (time_at(level, back) <= start) break;
+        fold(level, back, span);
+    }
+    return scanned;
+}
+
+} // namespace TotalMixer
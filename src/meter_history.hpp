@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "meter_bank.hpp"
+
+namespace TotalMixer {
+
+// Scrolling meter history: for every channel, a ring of the last depth() sampled frames (peak
+// and RMS display level, OVR) sharing one ring of timestamps. Levels are kept as bytes (the same
+// 0-255 quantization the OSC meter stream uses).
+//
+// Append() also folds the frames into coarser rings of min/max buckets, kFanout frames per
+// bucket at the first level, kFanout of those at the next, and so on. Decimate() reads the
+// coarsest level whose buckets are at most half an output column wide, so a draw scans at most
+// about 2 * kFanout entries per column: its cost follows the graph width and not the window
+// length, and the sampler is never held up by a long window. The storage is allocated by
+// Resize() and reused from then on, so the sampler appends without allocating.
+//
+// Append() belongs to the sampler thread; everything else may be called from any thread.
+class MeterHistory {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr int kChannels = MeterBank::kChannels;
+    static constexpr int kLevels = 4;   // raw frames, then buckets of 4, 16, 64 frames
+    static constexpr int kFanout = 4;
+
+    // One decimated column of a channel's history: the range the peak and RMS display levels
+    // covered and whether OVR was lit at any point. empty when no frame falls in the column.
+    struct Column {
+        float peak_min = 0.0f;
+        float peak_max = 0.0f;
+        float rms_min = 0.0f;
+        float rms_max = 0.0f;
+        bool overload = false;
+        bool empty = true;
+    };
+
+    // Keep `frames` frames per channel. Reallocates (the newest frames that still fit are kept);
+    // not meant for the sampling path.
+    void Resize(size_t frames);
+    size_t depth() const;
+
+    // Record one frame. Never allocates; a no-op while depth() is 0.
+    void Append(Clock::time_point time, const std::array<MeterLevel, kChannels>& levels);
+
+    void Clear();
+
+    // Fold channel ch over (end - window, end] into out[0..columns), oldest first. Returns the
+    // number of frames that fell in the window.
+    size_t Decimate(int ch, Clock::time_point end, Clock::duration window, Column* out, int columns) const;
+
+private:
+    // A frame (level 0) or a bucket of frames: the byte range it covered.
+    struct Cell {
+        uint8_t peak_min = 0;
+        uint8_t peak_max = 0;
+        uint8_t rms_min = 0;
+        uint8_t rms_max = 0;
+        uint8_t overload = 0;
+    };
+
+    struct Level {
+        size_t depth = 0;
+        uint64_t count = 0;                   // entries appended; the newest is at (count - 1) % depth
+        std::vector<Clock::time_point> times; // newest frame in the entry
+        std::vector<Cell> cells;              // channel-major: [ch * depth + slot]
+        std::array<Cell, kChannels> open{};   // bucket being filled (levels above 0)
+        int open_frames = 0;
+    };
+
+    void ResetLocked();
+    void AppendLocked(Clock::time_point time, const Cell* frame);
+
+    mutable std::mutex mtx_;
+    std::array<Level, kLevels> levels_;
+};
+
+} // namespace TotalMixer
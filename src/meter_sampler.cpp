@@ -0,0 +1,111 @@
+#include "meter_sampler.hpp"
+
+namespace TotalMixer {
+
+using Clock = std::chrono::steady_clock;
+
+MeterSampler::MeterSampler() {}
+
+MeterSampler::~MeterSampler() {
+    Stop();
+}
+
+void MeterSampler::Start(AlsaBackend* backend) {
+    Stop();
+    bank_.Reset();  // meter handles belong to the previous connection
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        backend_ = backend;
+        stop_ = false;
+        seq_ = 0;
+    }
+    frames_.back() = MeterFrame{};
+    frames_.publish();
+    if (backend) worker_ = std::thread(&MeterSampler::WorkerMain, this);
+}
+
+void MeterSampler::Stop() {
+    if (worker_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            stop_ = true;
+            cv_.notify_all();
+        }
+        worker_.join();
+    }
+    overloads_.EndAll();
+    std::lock_guard<std::mutex> lock(mtx_);
+    backend_ = nullptr;
+}
+
+void MeterSampler::SetActive(bool on) {
+    if (active_.load(std::memory_order_relaxed) == on) return;
+    std::lock_guard<std::mutex> lock(mtx_);
+    active_.store(on, std::memory_order_relaxed);
+    cv_.notify_all();
+}
+
+void MeterSampler::SetRate(int hz) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    rate_hz_ = hz < kMinRateHz ? kMinRateHz : (hz > kMaxRateHz ? kMaxRateHz : hz);
+    ResizeHistoryLocked();
+    cv_.notify_all();
+}
+
+void MeterSampler::SetPrefs(const MeterPreferences& prefs) {
+    bank_.SetPrefs(prefs);
+    std::lock_guard<std::mutex> lock(mtx_);
+    int seconds = prefs.history_seconds;
+    history_seconds_ = seconds < kMinHistorySeconds ? kMinHistorySeconds
+                     : (seconds > kMaxHistorySeconds ? kMaxHistorySeconds : seconds);
+    ResizeHistoryLocked();
+}
+
+// Called with mtx_ held, so the depth always matches the latest rate and length. The worker
+// appends outside mtx_; MeterHistory has its own lock for that.
+void MeterSampler::ResizeHistoryLocked() {
+    if (history_seconds_ > 0) history_.Resize(static_cast<size_t>(history_seconds_) * rate_hz_);
+}
+
+int MeterSampler::rate() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return rate_hz_;
+}
+
+// Fixed-rate loop: frames are due at a steady cadence from the first one, not a period after
+// the last read finished, so read time does not stretch the interval. A thread that falls more
+// than a period behind (stalled read, suspend) restarts the cadence instead of bursting.
+void MeterSampler::WorkerMain() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    Clock::time_point next = Clock::now();
+    while (!stop_) {
+        if (!active_.load(std::memory_order_relaxed)) {
+            overloads_.EndAll();  // nobody sees the levels while idle, so end what was lit
+            cv_.wait(lock, [this] { return stop_ || active_.load(std::memory_order_relaxed); });
+            next = Clock::now();
+            continue;
+        }
+        if (cv_.wait_until(lock, next, [this] { return stop_; })) break;
+
+        auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)) / rate_hz_;
+        AlsaBackend* backend = backend_;
+        lock.unlock();
+
+        auto now = Clock::now();
+        next = (now - next < period) ? next + period : now + period;
+        if (bank_.Poll(*backend, now)) {
+            MeterFrame& frame = frames_.back();
+            frame.time = now;
+            frame.seq = ++seq_;
+            frame.levels = bank_.levels();
+            frames_.publish();
+            history_.Append(now, frame.levels);
+            overloads_.Track(now, frame.levels);
+            if (sink_) sink_(frame);
+        }
+
+        lock.lock();
+    }
+}
+
+} // namespace TotalMixer
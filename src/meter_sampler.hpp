@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "alsa_backend.hpp"
+#include "meter_bank.hpp"
+#include "meter_history.hpp"
+#include "overload_log.hpp"
+#include "triple_buffer.hpp"
+
+namespace TotalMixer {
+
+// One sampled set of meter levels, after ballistics, in MeterBank channel order.
+struct MeterFrame {
+    std::chrono::steady_clock::time_point time;  // when the meter controls were read
+    uint64_t seq = 0;                            // frames sampled since Start() (0 = none yet)
+    std::array<MeterLevel, MeterBank::kChannels> levels{};
+};
+
+// Meter sampling thread. While active it reads every meter:* control at a fixed rate, runs the
+// MeterBank ballistics on the same thread and publishes each timestamped frame through a triple
+// buffer, so the frame clock of whoever displays meters never sets (or stalls) the sampling, and
+// no meter read ever sits on a render or service path. Every frame is also appended to the
+// history() rings, sized to MeterPreferences::history_seconds at the current rate, and tracked
+// by the overloads() log (which records only once the owner opens it for writing).
+//
+// latest() has a single reader thread (the frontend); the sink, if set, runs on the sampler
+// thread after every frame. Everything else may be called from any thread.
+class MeterSampler {
+public:
+    static constexpr int kDefaultRateHz = 30;
+    static constexpr int kMinRateHz = 10;
+    static constexpr int kMaxRateHz = 100;
+    static constexpr int kMinHistorySeconds = 2;
+    static constexpr int kMaxHistorySeconds = 120;
+
+    using FrameSink = std::function<void(const MeterFrame&)>;
+
+    MeterSampler();
+    ~MeterSampler();
+
+    MeterSampler(const MeterSampler&) = delete;
+    MeterSampler& operator=(const MeterSampler&) = delete;
+
+    // Attach to a backend (a new connection: meter controls are resolved again) and start the
+    // thread. Stop() joins it and detaches; call it before the backend goes away.
+    void Start(AlsaBackend* backend);
+    void Stop();
+
+    // Sample only while someone wants meters. An inactive sampler sleeps without reading.
+    void SetActive(bool on);
+    bool active() const { return active_.load(std::memory_order_relaxed); }
+
+    // Frames per second, clamped to kMinRateHz..kMaxRateHz. Takes effect from the next frame.
+    void SetRate(int hz);
+    int rate() const;
+
+    // Ballistics tuning and history length; takes effect from the next frame.
+    void SetPrefs(const MeterPreferences& prefs);
+
+    // Per-channel level history (any thread may read it).
+    const MeterHistory& history() const { return history_; }
+
+    // Persistent overload log fed from every frame (any thread may read it).
+    OverloadLog& overloads() { return overloads_; }
+    const OverloadLog& overloads() const { return overloads_; }
+
+    // Called on the sampler thread with every frame. Set before Start().
+    void SetSink(FrameSink sink) { sink_ = std::move(sink); }
+
+    // Most recently published frame (single reader thread; never blocks).
+    const MeterFrame& latest() { return frames_.front(); }
+
+private:
+    void WorkerMain();
+    void ResizeHistoryLocked();
+
+    MeterBank bank_;
+    MeterHistory history_;
+    OverloadLog overloads_;
+    TripleBuffer<MeterFrame> frames_;
+    FrameSink sink_;
+
+    AlsaBackend* backend_ = nullptr;
+    int rate_hz_ = kDefaultRateHz;
+    int history_seconds_ = 0;
+    bool stop_ = false;
+    std::atomic<bool> active_{false};
+    uint64_t seq_ = 0;
+
+    mutable std::mutex mtx_;
+    std::condition_variable cv_;
+    std::thread worker_;
+};
+
+} // namespace TotalMixer
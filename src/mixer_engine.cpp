@@ -1,6 +1,10 @@
 #include "mixer_engine.hpp"
 #include "config_manager.hpp"
+#include <algorithm>
 #include <iostream>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
 
 namespace TotalMixer {
 
@@ -10,6 +14,83 @@ using std::chrono::milliseconds;
 
 static inline long clamp_gain(long v) { return v < 0 ? 0 : (v > 65536 ? 65536 : v); }
 
+// Full hardware poll period. Without control events it is the only sync path; with them it is
+// just a scrubber for anything a lost event would leave stale.
+static constexpr long kPollIntervalMs = 500;
+static constexpr long kScrubIntervalMs = 5000;
+// Retry period for work Tick() has to put off (dirty rows during a drag, queued writes).
+static constexpr long kThreadTickMs = 5;
+// OSC feedback push period (~20Hz) and the quiet time after our own write before a poll.
+static constexpr long kOscPushIntervalMs = 50;
+static constexpr long kPollAfterWriteMs = 200;
+
+// Hardware inputs are split over three ALSA controls. Map a global input (0-17) onto the control
+// that carries it and the row index within that control.
+static const char* InputGainControl(int src_idx, int& hw_idx) {
+    if (src_idx < 8)  { hw_idx = src_idx;      return "mixer:analog-source-gain"; }
+    if (src_idx < 10) { hw_idx = src_idx - 8;  return "mixer:spdif-source-gain"; }
+    hw_idx = src_idx - 10;
+    return "mixer:adat-source-gain";
+}
+
+// Collapse one drain of inbound OSC commands before it is applied. A fader command superseded by
+// a later fader command for the same (type, index[, output]) is dropped, and the survivor moves to where
+// the last one was, so the relative order of the commands that remain is the order in which
+// their final values arrived. Faders are absolute sets, and link state and the selected submix
+// are constant between barriers, so the end state is the same as applying every command.
+// Everything else (mutes, solos, links, submix select, queries) is kept as-is and acts as a
+// barrier: nothing is merged across it. Works in place. Returns the number of commands dropped.
+static size_t CoalesceOscCommands(std::vector<OscCommand>& cmds) {
+    // Fader target -> position in cmds, or -1. Out/in/pb faders take 18 entries each, the
+    // /mix/* crosspoint faders 18x18 each.
+    static constexpr int kTargets = 3 * 18 + 2 * 18 * 18;
+    int live[kTargets];
+    bool any_live = true;
+    auto reset = [&] {
+        if (!any_live) return;
+        std::fill(std::begin(live), std::end(live), -1);
+        any_live = false;
+    };
+    reset();
+
+    size_t dropped = 0;
+    for (size_t i = 0; i < cmds.size(); ++i) {
+        const OscCommand& cmd = cmds[i];
+        int kind = -1;
+        int slot = cmd.index;
+        switch (cmd.type) {
+            case OscCmdType::OutFader:   kind = 0; break;
+            case OscCmdType::InFader:    kind = 1; slot += 18; break;
+            case OscCmdType::PbFader:    kind = 2; slot += 2 * 18; break;
+            case OscCmdType::MixInFader: kind = 3; slot += 3 * 18 + cmd.output * 18; break;
+            case OscCmdType::MixPbFader: kind = 4; slot += 3 * 18 + (18 + cmd.output) * 18; break;
+            default: break;
+        }
+        if (kind < 0 || cmd.index < 0 || cmd.index >= 18 || cmd.output < 0 || cmd.output >= 18) {
+            reset();
+            continue;
+        }
+        any_live = true;
+        int& pos = live[slot];
+        if (pos >= 0) {
+            OscCommand& prev = cmds[pos];
+            // A source fader raised above 0 also unmutes; keep that step if the final value is 0.
+            bool keeps_unmute = kind != 0 && prev.value > 0.0f && cmd.value <= 0.0f;
+            if (!keeps_unmute) {
+                prev.type = OscCmdType::Unknown;  // tombstone: ApplyOscCommand ignores it
+                dropped++;
+            }
+        }
+        pos = static_cast<int>(i);
+    }
+    if (dropped > 0) {
+        cmds.erase(std::remove_if(cmds.begin(), cmds.end(),
+                                  [](const OscCommand& c) { return c.type == OscCmdType::Unknown; }),
+                   cmds.end());
+    }
+    return dropped;
+}
+
 MixerEngine::MixerEngine()
     : last_write_time(steady_clock::now()),
       last_poll_time(steady_clock::now()),
@@ -17,21 +98,51 @@ MixerEngine::MixerEngine()
     master_states.resize(18);
     master_last_write_time.resize(18, steady_clock::now() - std::chrono::seconds(10));
 
-    // OSC feedback diff snapshots (sentinel -1 forces a first send; resync also overrides).
-    osc_last_out_fader.assign(18, -1);
-    osc_last_in_fader.assign(18, -1);
-    osc_last_pb_fader.assign(18, -1);
-    osc_last_out_mute.assign(18, -1);
-    osc_last_out_solo.assign(18, -1);
-    osc_last_out_link.assign(18, -1);
-    osc_last_in_mute.assign(18, -1);
-    osc_last_pb_mute.assign(18, -1);
+    // Every feedback address, encoded once. New address families get their table entry here.
+    // Each gets its own slot, under which every OSC client remembers what it was last sent.
+    uint32_t slot = 0;
+    auto family = [&slot](std::array<OscFloatMessage, 18>& fam, const char* prefix, uint32_t bit) {
+        for (int i = 0; i < 18; ++i) fam[i] = OscFloatMessage(prefix + std::to_string(i + 1), bit, slot++);
+    };
+    osc_addr.submix_current = OscFloatMessage("/submix/current", OscFamilySubmix, slot++);
+    family(osc_addr.out_fader, "/out/fader/", OscFamilyOut);
+    family(osc_addr.out_mute, "/out/mute/", OscFamilyOut);
+    family(osc_addr.out_solo, "/out/solo/", OscFamilyOut);
+    family(osc_addr.out_link, "/out/link/", OscFamilyOut);
+    family(osc_addr.in_fader, "/in/fader/", OscFamilyIn);
+    family(osc_addr.in_mute, "/in/mute/", OscFamilyIn);
+    family(osc_addr.pb_fader, "/pb/fader/", OscFamilyPb);
+    family(osc_addr.pb_mute, "/pb/mute/", OscFamilyPb);
+    for (int o = 0; o < 18; ++o) {
+        std::string mix = "/mix/" + std::to_string(o + 1);
+        family(osc_addr.mix_in_fader[o], (mix + "/in/fader/").c_str(), OscFamilyMix);
+        family(osc_addr.mix_in_mute[o], (mix + "/in/mute/").c_str(), OscFamilyMix);
+        family(osc_addr.mix_pb_fader[o], (mix + "/pb/fader/").c_str(), OscFamilyMix);
+        family(osc_addr.mix_pb_mute[o], (mix + "/pb/mute/").c_str(), OscFamilyMix);
+    }
+
+    // Load persisted preferences (meter, OSC and display blocks share preferences.json).
+    ConfigManager::Load(meter_prefs, osc_prefs, display_prefs);
+    ApplyMeterPrefs();
+
+    // OSC meter streaming happens on the sampler thread, straight from each frame.
+    meters.SetSink([this](const MeterFrame& frame) {
+        OscServer* server = meter_osc.load(std::memory_order_acquire);
+        if (!server || !server->IsRunning() || !server->WantsMeters()) return;
+        MeterBank::EncodeLevels(frame.levels, meter_blob.data());
+        server->SendMeters(meter_blob.data(), meter_blob.size());
+    });
 
-    // Load persisted preferences (both meter and OSC blocks share preferences.json).
-    ConfigManager::Load(meter_prefs, osc_prefs);
+    thread_wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (thread_wake_fd < 0) std::cerr << "Engine: eventfd failed; engine thread will poll" << std::endl;
 }
 
-MixerEngine::~MixerEngine() {}
+MixerEngine::~MixerEngine() {
+    StopThread();
+    meters.Stop();
+    writes.Stop();
+    if (thread_wake_fd >= 0) close(thread_wake_fd);
+}
 
 // ── Startup ──
 void MixerEngine::CheckServiceStatus() {
@@ -47,18 +158,51 @@ MixerEngine::InitResult MixerEngine::Init(int card_index) {
         std::cerr << "Engine Error: snd-fireface-ctl.service is not running" << std::endl;
         return InitResult{false, service_status};
     }
+    // Only real hardware records overloads: simulated cards (bench, --simulate) keep out of the
+    // user's log. The sampler tracks it across reconnects. While another process records into it,
+    // map it to read and clear instead, and try to take over recording on the next reconnect.
+    OverloadLog& overloads = meters.overloads();
+    if (!overloads.recording() && !overloads.OpenForWriting(OverloadLog::DefaultPath())) {
+        overloads.Open(OverloadLog::DefaultPath(), true);
+    }
     try {
-        alsa_ = std::make_unique<AlsaCore>(card_index);
-        std::cout << "Engine: Connected to " << alsa_->get_card_name() << std::endl;
-        PollHardware();
-        return InitResult{true, service_status};
+        return Attach(std::make_unique<AlsaCore>(card_index));
     } catch (const std::exception& e) {
         std::cerr << "Engine Warning: Failed to connect to ALSA: " << e.what() << std::endl;
+        meters.Stop();
+        writes.Stop();
         alsa_.reset();
         return InitResult{false, service_status};
     }
 }
 
+MixerEngine::InitResult MixerEngine::Init(std::unique_ptr<AlsaBackend> backend) {
+    service_status = ServiceStatus::Running;
+    if (!backend) return InitResult{false, service_status};
+    return Attach(std::move(backend));
+}
+
+MixerEngine::InitResult MixerEngine::Attach(std::unique_ptr<AlsaBackend> backend) {
+    meters.Stop();
+    writes.Stop();  // flushes into the old backend before it is replaced
+    alsa_ = std::move(backend);
+    hw_lost.store(false, std::memory_order_relaxed);
+    std::cout << "Engine: Connected to " << alsa_->get_card_name() << std::endl;
+    // Subscribe before the first poll so nothing that changes in between is missed.
+    hw_events = alsa_->subscribe_events();
+    if (!hw_events) {
+        std::cerr << "Engine Warning: control events unavailable, falling back to "
+                  << kPollIntervalMs << "ms polling" << std::endl;
+    }
+    hw_rescan = false;
+    ResolveControls();
+    PollHardware();
+    writes.Start(alsa_.get());
+    meters.Start(alsa_.get());  // resolves the meter controls afresh
+    PublishSnapshot();
+    return InitResult{true, service_status};
+}
+
 // ── Submix helpers ──
 int MixerEngine::OutputLinkPartner(int ch) const {
     if (ch < 0 || ch >= (int)master_states.size()) return -1;
@@ -77,25 +221,43 @@ bool MixerEngine::IsOutputSelected(int ch) const {
 // ── Crosspoint write ──
 bool MixerEngine::WriteSourceGain(bool is_playback, int src_idx, int output, long val) {
     if (!alsa_) return false;
-    std::string mixer_name = is_playback ? "mixer:stream-source-gain" :
-                             (src_idx < 8 ? "mixer:analog-source-gain" :
-                             (src_idx < 10 ? "mixer:spdif-source-gain" : "mixer:adat-source-gain"));
-    int hw_in_idx = is_playback ? src_idx : (src_idx < 8 ? src_idx : (src_idx < 10 ? src_idx - 8 : src_idx - 10));
-    return alsa_->set_matrix_gain(mixer_name, hw_in_idx, output, val);
+    if (src_idx < 0 || src_idx >= 18 || output < 0) return false;
+    if (crosspoint_batch_depth > 0) {
+        crosspoint_txn.set(SourceRow(is_playback, src_idx), output, val);
+        return true;
+    }
+    writes.Set(SourceRow(is_playback, src_idx), output, val);
+    return true;
+}
+
+void MixerEngine::BeginCrosspointBatch() {
+    ++crosspoint_batch_depth;
+}
+
+bool MixerEngine::CommitCrosspointBatch() {
+    if (crosspoint_batch_depth == 0) return true;
+    if (--crosspoint_batch_depth > 0) return true;
+    if (crosspoint_txn.empty()) return true;
+    bool ok = alsa_ != nullptr;
+    if (ok) writes.Set(crosspoint_txn);
+    crosspoint_txn.clear();
+    return ok;
 }
 
 // ── Shared apply primitives ──
 bool MixerEngine::WriteAllMasterVolumes() {
     if (!alsa_) return false;
-    std::vector<long> all_v(18);
     bool any_solo = false;
     for (int i = 0; i < 18; ++i) {
         if (master_states[i].is_soloed) { any_solo = true; break; }
     }
+    // Queued as one transaction so the solo-suppressed set is never flushed half-way.
+    MatrixTransaction txn;
     for (int i = 0; i < 18; ++i) {
-        all_v[i] = (any_solo && !master_states[i].is_soloed) ? 0 : master_states[i].value;
+        txn.set(ctl_output_volume, i, (any_solo && !master_states[i].is_soloed) ? 0 : master_states[i].value);
     }
-    return alsa_->set_control_value("output-volume", 0, all_v);
+    writes.Set(txn);
+    return true;
 }
 
 void MixerEngine::SetMasterVolume(int ch, long val) {
@@ -157,67 +319,68 @@ void MixerEngine::SetMasterLink(int ch, bool linked) {
 void MixerEngine::SetSourceGain(bool is_playback, int src_idx, int output, long val) {
     if (src_idx < 0 || src_idx >= 18 || output < 0 || output >= 18) return;
     val = clamp_gain(val);
-    auto& cache = is_playback ? playback_matrix_cache : input_matrix_cache;
-    auto& mute_state = is_playback ? playback_mute_state : input_mute_state;
-    if (val > 0) mute_state.erase({output, src_idx});  // raising level clears mute
-    cache[{output, src_idx}] = val;
+    MatrixState& m = Matrix(is_playback);
+    if (val > 0) m.muted[output].reset(src_idx);  // raising level clears mute
+    BeginCrosspointBatch();  // output + linked partner share the source row: one write
+    m.gain[output][src_idx] = val;
     WriteSourceGain(is_playback, src_idx, output, val);
     int partner = OutputLinkPartner(output);
     if (partner != -1) {
-        cache[{partner, src_idx}] = val;
+        m.gain[partner][src_idx] = val;
         WriteSourceGain(is_playback, src_idx, partner, val);
     }
+    CommitCrosspointBatch();
     last_write_time = steady_clock::now();
 }
 
 void MixerEngine::SetSourceMute(bool is_playback, int src_idx, int output, bool mute) {
     if (src_idx < 0 || src_idx >= 18 || output < 0 || output >= 18) return;
-    auto& cache = is_playback ? playback_matrix_cache : input_matrix_cache;
-    auto& mute_state = is_playback ? playback_mute_state : input_mute_state;
-    bool cur = mute_state.count({output, src_idx}) > 0;
+    MatrixState& m = Matrix(is_playback);
+    bool cur = m.muted[output].test(src_idx);
     if (cur == mute) return;
     int partner = OutputLinkPartner(output);
+    BeginCrosspointBatch();
     if (mute) {
-        mute_state[{output, src_idx}] = cache[{output, src_idx}];
+        m.muted[output].set(src_idx);
+        m.saved[output][src_idx] = m.gain[output][src_idx];
         WriteSourceGain(is_playback, src_idx, output, 0);
-        cache[{output, src_idx}] = 0;
+        m.gain[output][src_idx] = 0;
         if (partner != -1) {
             WriteSourceGain(is_playback, src_idx, partner, 0);
-            cache[{partner, src_idx}] = 0;
+            m.gain[partner][src_idx] = 0;
         }
     } else {
-        long saved = mute_state[{output, src_idx}];
-        mute_state.erase({output, src_idx});
+        long saved = m.saved[output][src_idx];
+        m.muted[output].reset(src_idx);
         WriteSourceGain(is_playback, src_idx, output, saved);
-        cache[{output, src_idx}] = saved;
+        m.gain[output][src_idx] = saved;
         if (partner != -1) {
             WriteSourceGain(is_playback, src_idx, partner, saved);
-            cache[{partner, src_idx}] = saved;
+            m.gain[partner][src_idx] = saved;
         }
     }
+    CommitCrosspointBatch();
     last_write_time = steady_clock::now();
 }
 
 void MixerEngine::SetSubmix(int output) {
     if (output < 0 || output >= 18) return;
     selected_output = output;
-    osc_resync = true;
+    osc_push_pending = true;  // /submix/select feedback
 }
 
 long MixerEngine::sourceGain(bool is_playback, int output, int src_idx) const {
-    const auto& cache = is_playback ? playback_matrix_cache : input_matrix_cache;
-    auto it = cache.find({output, src_idx});
-    return it == cache.end() ? 0 : it->second;
+    if (output < 0 || output >= 18 || src_idx < 0 || src_idx >= 18) return 0;
+    return Matrix(is_playback).gain[output][src_idx];
 }
 
 bool MixerEngine::sourceMuted(bool is_playback, int output, int src_idx) const {
-    const auto& mute_state = is_playback ? playback_mute_state : input_mute_state;
-    return mute_state.count({output, src_idx}) > 0;
+    if (output < 0 || output >= 18 || src_idx < 0 || src_idx >= 18) return false;
+    return Matrix(is_playback).muted[output].test(src_idx);
 }
 
 long& MixerEngine::crosspoint(bool is_playback, int output, int src_idx) {
-    auto& cache = is_playback ? playback_matrix_cache : input_matrix_cache;
-    return cache[{output, src_idx}];
+    return Matrix(is_playback).gain[output][src_idx];
 }
 
 bool MixerEngine::WriteCrosspointRaw(bool is_playback, int src_idx, int output, long val) {
@@ -249,12 +412,27 @@ bool MixerEngine::oscHasClient() const {
 
 // ── OSC endpoint glue ──
 void MixerEngine::RestartOscServer() {
-    if (!osc) osc = std::make_unique<OscServer>();
+    if (threaded()) {
+        // The OscServer belongs to the engine thread; hand it a copy of the prefs as they are now.
+        std::lock_guard<std::mutex> lock(cmd_mtx);
+        osc_restart_prefs = osc_prefs;
+        osc_restart_pending = true;
+        WakeThread();
+        return;
+    }
+    StartOsc(osc_prefs);
+}
+
+void MixerEngine::StartOsc(const OscPreferences& prefs) {
+    if (!osc) {
+        osc = std::make_unique<OscServer>();
+        osc_dropped_reported = 0;
+        meter_osc.store(osc.get(), std::memory_order_release);
+    }
     osc->Stop();
-    if (osc_prefs.enabled) {
-        osc->Start(osc_prefs.in_port, osc_prefs.out_port);
+    if (prefs.enabled) {
+        osc->Start(prefs.in_port, prefs.out_port);
     }
-    osc_resync = true;  // force a full state dump once a client appears
 }
 
 void MixerEngine::StopOsc() {
@@ -274,64 +452,127 @@ void MixerEngine::ApplyOscCommand(const OscCommand& cmd) {
         case OscCmdType::PbFader:  SetSourceGain(true, cmd.index, selected_output, raw); break;
         case OscCmdType::PbMute:   SetSourceMute(true, cmd.index, selected_output, on); break;
         case OscCmdType::SubmixSelect:
-            if (cmd.index >= 0 && cmd.index < 18) { selected_output = cmd.index; osc_resync = true; }
+            if (cmd.index >= 0 && cmd.index < 18) selected_output = cmd.index;
             break;
-        case OscCmdType::QueryAll: osc_resync = true; break;
+        case OscCmdType::MixInFader: SetSourceGain(false, cmd.index, cmd.output, raw); break;
+        case OscCmdType::MixInMute:  SetSourceMute(false, cmd.index, cmd.output, on); break;
+        case OscCmdType::MixPbFader: SetSourceGain(true, cmd.index, cmd.output, raw); break;
+        case OscCmdType::MixPbMute:  SetSourceMute(true, cmd.index, cmd.output, on); break;
         default: break;
     }
 }
 
-// Diff-based feedback: send only the control values that changed since the last push (or all of
-// them on a forced resync). One path covers UI edits, hardware poll changes, and OSC-applied
-// changes uniformly. Source rows are view-coupled to the currently selected submix.
+// Feedback: submit the current value of every address; OscServer diffs them per client and sends
+// each controller only what changed since its last push (everything for a new client or after
+// its /query). One path covers UI edits, hardware poll changes, and OSC-applied changes
+// uniformly. Source rows are view-coupled to the currently selected submix.
 void MixerEngine::SendOscState() {
     if (!osc || !osc->IsRunning() || !osc->HasClient()) return;
 
-    bool full = osc_resync || (selected_output != osc_last_sent_submix);
     const float N = 65536.0f;
-    auto sendf = [&](const std::string& p, float v) { osc->SendFloat(p, v); };
-
-    if (selected_output != osc_last_sent_submix) {
-        sendf("/submix/current", (float)(selected_output + 1));
-        osc_last_sent_submix = selected_output;
+    auto sendf = [&](const OscFloatMessage& m, float v) { osc->SendFloat(m, v); };
+    // Families nobody subscribes to are not even collected.
+    const bool out = osc->AnySubscribed(OscFamilyOut);
+    const bool in = osc->AnySubscribed(OscFamilyIn);
+    const bool pb = osc->AnySubscribed(OscFamilyPb);
+    const bool mix = osc->AnySubscribed(OscFamilyMix);
+
+    // Everything below goes out together as one or a few bundles per client.
+    osc->BeginFeedback();
+    sendf(osc_addr.submix_current, (float)(selected_output + 1));
+
+    const auto& in_gain = input_matrix.gain[selected_output];
+    const auto& pb_gain = playback_matrix.gain[selected_output];
+    const auto& in_muted = input_matrix.muted[selected_output];
+    const auto& pb_muted = playback_matrix.muted[selected_output];
+    for (int i = 0; i < 18; ++i) {
+        if (out) {
+            sendf(osc_addr.out_fader[i], master_states[i].value / N);
+            sendf(osc_addr.out_mute[i], master_states[i].is_muted ? 1.0f : 0.0f);
+            sendf(osc_addr.out_solo[i], master_states[i].is_soloed ? 1.0f : 0.0f);
+            sendf(osc_addr.out_link[i], master_states[i].is_linked ? 1.0f : 0.0f);
+        }
+        if (in) {
+            sendf(osc_addr.in_fader[i], in_gain[i] / N);
+            sendf(osc_addr.in_mute[i], in_muted.test(i) ? 1.0f : 0.0f);
+        }
+        if (pb) {
+            sendf(osc_addr.pb_fader[i], pb_gain[i] / N);
+            sendf(osc_addr.pb_mute[i], pb_muted.test(i) ? 1.0f : 0.0f);
+        }
     }
+    // The whole matrix, independent of the selected submix.
+    if (mix) {
+        for (int o = 0; o < 18; ++o) {
+            for (int i = 0; i < 18; ++i) {
+                sendf(osc_addr.mix_in_fader[o][i], input_matrix.gain[o][i] / N);
+                sendf(osc_addr.mix_in_mute[o][i], input_matrix.muted[o].test(i) ? 1.0f : 0.0f);
+                sendf(osc_addr.mix_pb_fader[o][i], playback_matrix.gain[o][i] / N);
+                sendf(osc_addr.mix_pb_mute[o][i], playback_matrix.muted[o].test(i) ? 1.0f : 0.0f);
+            }
+        }
+    }
+    osc->EndFeedback();
+}
 
-    for (int i = 0; i < 18; ++i) {
-        std::string n = std::to_string(i + 1);
+// ── Event loop support ──
+long MixerEngine::NextTickDelayMs() const {
+    auto now = steady_clock::now();
+    steady_clock::time_point next = steady_clock::time_point::max();
+    auto consider = [&next](steady_clock::time_point t) { if (t < next) next = t; };
+
+    if (alsa_) {
+        // Hardware sync: the scrubber (or plain polling), and rows named by control events,
+        // both held back until our own writes have settled.
+        bool dirty = hw_rescan || hw_master_dirty || hw_input_dirty.any() || hw_playback_dirty.any();
+        auto poll_at = last_poll_time + milliseconds((hw_events ? kScrubIntervalMs : kPollIntervalMs) + 1);
+        if (dirty) poll_at = now;
+        poll_at = std::max(poll_at, last_write_time + milliseconds(kPollAfterWriteMs));
+        if (!writes.idle()) poll_at = std::max(poll_at, now + milliseconds(kThreadTickMs));
+        consider(poll_at);
+    }
+    if (osc && osc->IsRunning() && osc->HasClient() &&
+        (osc_push_pending || last_write_time >= last_osc_push_time)) {
+        consider(last_osc_push_time + milliseconds(kOscPushIntervalMs + 1));
+    }
 
-        long ov = master_states[i].value;
-        if (full || ov != osc_last_out_fader[i]) { sendf("/out/fader/" + n, ov / N); osc_last_out_fader[i] = ov; }
-        int om = master_states[i].is_muted ? 1 : 0;
-        if (full || om != osc_last_out_mute[i]) { sendf("/out/mute/" + n, (float)om); osc_last_out_mute[i] = om; }
-        int os = master_states[i].is_soloed ? 1 : 0;
-        if (full || os != osc_last_out_solo[i]) { sendf("/out/solo/" + n, (float)os); osc_last_out_solo[i] = os; }
-        int ol = master_states[i].is_linked ? 1 : 0;
-        if (full || ol != osc_last_out_link[i]) { sendf("/out/link/" + n, (float)ol); osc_last_out_link[i] = ol; }
+    if (next == steady_clock::time_point::max()) return -1;
+    if (next <= now) return 0;
+    // Round up so the caller never wakes a hair early and spins.
+    return static_cast<long>(std::chrono::ceil<milliseconds>(next - now).count());
+}
 
-        long iv = input_matrix_cache[{selected_output, i}];
-        if (full || iv != osc_last_in_fader[i]) { sendf("/in/fader/" + n, iv / N); osc_last_in_fader[i] = iv; }
-        int im = input_mute_state.count({selected_output, i}) ? 1 : 0;
-        if (full || im != osc_last_in_mute[i]) { sendf("/in/mute/" + n, (float)im); osc_last_in_mute[i] = im; }
+// ── Metering ──
+// The sampler runs only while someone looks: a frontend that enabled meters, or an OSC client
+// that asked for them (the daemon otherwise never touches the meter controls).
+void MixerEngine::SetMetersEnabled(bool on) {
+    meters_enabled.store(on, std::memory_order_relaxed);
+    WakeThread();  // the engine thread applies it (it owns the OSC side of the decision)
+}
 
-        long pv = playback_matrix_cache[{selected_output, i}];
-        if (full || pv != osc_last_pb_fader[i]) { sendf("/pb/fader/" + n, pv / N); osc_last_pb_fader[i] = pv; }
-        int pm = playback_mute_state.count({selected_output, i}) ? 1 : 0;
-        if (full || pm != osc_last_pb_mute[i]) { sendf("/pb/mute/" + n, (float)pm); osc_last_pb_mute[i] = pm; }
-    }
-    osc_resync = false;
+void MixerEngine::UpdateMeterSampling() {
+    bool osc_meters = osc && osc->IsRunning() && osc->WantsMeters();
+    meters.SetActive(alsa_ && !hardwareLost() && (osc_meters || meters_enabled.load(std::memory_order_relaxed)));
 }
 
 // ── Hardware polling ──
 void MixerEngine::PollHardware() {
     if (!alsa_) return;
+    osc_push_pending = external_change = true;  // anything may have changed
+    if (hw_rescan) ResolveControls();  // element set changed: numids may have moved
     try {
         PollMasterVolumes();
         PollPlaybackMatrix();
         PollInputMatrix();
     } catch (...) {}
+    // A full poll covers every row, so anything events had queued is now current.
+    hw_rescan = false;
+    hw_master_dirty = false;
+    hw_input_dirty.reset();
+    hw_playback_dirty.reset();
 }
 
-void MixerEngine::PollMasterVolumes() {
+void MixerEngine::PollMasterVolumes(bool cached) {
     if (!alsa_) return;
     try {
         // While any channel is soloed, the hardware output-volume of non-soloed channels is
@@ -341,90 +582,324 @@ void MixerEngine::PollMasterVolumes() {
         for (int i = 0; i < 18; ++i) {
             if (master_states[i].is_soloed) return;
         }
-        auto mv = alsa_->get_matrix_row("output-volume", 0, 18);
-        if (mv) {
+        long mv[18];
+        int n = cached ? alsa_->read_cached(ctl_output_volume, mv, 18) : alsa_->read(ctl_output_volume, mv, 18);
+        if (n > 0) {
             auto now = steady_clock::now();
-            for (size_t i = 0; i < mv->size() && i < 18; ++i) {
+            for (int i = 0; i < n; ++i) {
                 // Skip if muted or soloed (user control in progress)
                 if (master_states[i].is_muted || master_states[i].is_soloed) continue;
                 // Skip updating if this specific fader was written to in the last 2000ms
                 auto elapsed = duration_cast<milliseconds>(now - master_last_write_time[i]).count();
                 if (elapsed < 2000) continue;
 
-                master_states[i].value = (*mv)[i];
+                master_states[i].value = mv[i];
             }
         }
     } catch (...) {}
 }
 
 void MixerEngine::PollInputMatrix() {
+    for (int src = 0; src < 18; ++src) PollInputRow(src);
+}
+
+void MixerEngine::PollPlaybackMatrix() {
+    for (int src = 0; src < 18; ++src) PollPlaybackRow(src);
+}
+
+// One source row: the gains of src_idx into all 18 outputs. The held (dragged) cell is left alone.
+// cached = take the row from the backend's shadow copy, which read_events() has already refreshed
+// for every row an event named; the periodic scrub passes false to go to the hardware.
+void MixerEngine::PollInputRow(int src_idx, bool cached) {
     try {
-        std::vector<std::string> ctl_names = {"mixer:analog-source-gain", "mixer:spdif-source-gain", "mixer:adat-source-gain"};
-        std::vector<int> offsets = {0, 8, 10};
-        for (size_t grp = 0; grp < ctl_names.size(); ++grp) {
-            int base_in = offsets[grp];
-            int count = (grp == 0) ? 8 : ((grp == 1) ? 2 : 8);
-            for (int local_in = 0; local_in < count; ++local_in) {
-                auto r = alsa_->get_matrix_row(ctl_names[grp], local_in, 18);
-                if (r) {
-                    int global_in = base_in + local_in;
-                    for (size_t o = 0; o < r->size(); ++o) {
-                        if (has_held_cell &&
-                            held_cell.first == static_cast<int>(o) &&
-                            held_cell.second == global_in) {
-                            continue;
-                        }
-                        input_matrix_cache[{static_cast<int>(o), global_in}] = (*r)[o];
-                    }
-                }
-            }
+        long r[18];
+        const ControlHandle& h = ctl_input_rows[src_idx];
+        int n = cached ? alsa_->read_cached(h, r, 18) : alsa_->read(h, r, 18);
+        for (int o = 0; o < n; ++o) {
+            if (isHeldCrosspoint(o, src_idx)) continue;
+            input_matrix.gain[o][src_idx] = r[o];
         }
     } catch (...) {}
 }
 
-void MixerEngine::PollPlaybackMatrix() {
+void MixerEngine::PollPlaybackRow(int src_idx, bool cached) {
     try {
-        for (int o = 0; o < 18; ++o) {
-            auto r_pb = alsa_->get_matrix_row("mixer:stream-source-gain", o, 18);
-            if (r_pb) {
-                for (size_t i = 0; i < r_pb->size(); ++i) {
-                    if (has_held_cell &&
-                        held_cell.first == static_cast<int>(i) &&
-                        held_cell.second == o) {
-                        continue;
-                    }
-                    playback_matrix_cache[{static_cast<int>(i), o}] = (*r_pb)[i];
-                }
-            }
+        long r[18];
+        const ControlHandle& h = ctl_playback_rows[src_idx];
+        int n = cached ? alsa_->read_cached(h, r, 18) : alsa_->read(h, r, 18);
+        for (int o = 0; o < n; ++o) {
+            if (isHeldCrosspoint(o, src_idx)) continue;
+            playback_matrix.gain[o][src_idx] = r[o];
         }
     } catch (...) {}
 }
 
+// Look up the mixer controls by name once. Unresolvable rows keep an invalid handle, which makes
+// their reads/writes fail quietly exactly like the old by-name calls did.
+void MixerEngine::ResolveControls() {
+    auto resolve = [this](const char* name, unsigned int index) {
+        auto h = alsa_->resolve(name, index);
+        return h ? *h : ControlHandle{};
+    };
+    ctl_output_volume = resolve("output-volume", 0);
+    for (int src = 0; src < 18; ++src) {
+        int hw_idx = 0;
+        const char* ctl = InputGainControl(src, hw_idx);
+        ctl_input_rows[src] = resolve(ctl, hw_idx);
+        ctl_playback_rows[src] = resolve("mixer:stream-source-gain", src);
+    }
+}
+
+// Drain the control event stream and remember which rows changed. Reading them back is left to
+// PollDirtyRows so the usual drag/recent-write guards still apply. Events for anything we do not
+// mirror (meters, clock, options) are simply dropped.
+void MixerEngine::CollectHardwareEvents() {
+    if (!alsa_ || !hw_events || hardwareLost()) return;
+    alsa_->read_events(hw_event_buf);
+    if (alsa_->events_lost()) {
+        MarkHardwareLost();
+        return;
+    }
+    for (const ControlEvent& ev : hw_event_buf) {
+        if (!ev.value_changed()) {
+            hw_rescan = true;  // element added/removed/re-described: trust nothing, poll it all
+            continue;
+        }
+        if (ev.numid == ctl_output_volume.numid) {
+            hw_master_dirty = true;
+            continue;
+        }
+        for (int src = 0; src < 18; ++src) {
+            if (ev.numid == ctl_input_rows[src].numid) { hw_input_dirty.set(src); break; }
+            if (ev.numid == ctl_playback_rows[src].numid) { hw_playback_dirty.set(src); break; }
+        }
+    }
+}
+
+void MixerEngine::MarkHardwareLost() {
+    if (hw_lost.exchange(true, std::memory_order_relaxed)) return;
+    std::cerr << "Engine Error: lost the card (disconnected or service stopped)" << std::endl;
+    meters.SetActive(false);
+    if (change_listener) change_listener();
+}
+
+void MixerEngine::PollDirtyRows() {
+    if (!alsa_) return;
+    if (hw_rescan) {
+        PollHardware();
+        return;
+    }
+    if (hw_master_dirty) {
+        PollMasterVolumes(true);
+        hw_master_dirty = false;
+        osc_push_pending = external_change = true;
+    }
+    if (hw_input_dirty.none() && hw_playback_dirty.none()) return;
+    osc_push_pending = external_change = true;
+    for (int src = 0; src < 18; ++src) {
+        if (hw_input_dirty.test(src)) PollInputRow(src, true);
+        if (hw_playback_dirty.test(src)) PollPlaybackRow(src, true);
+    }
+    hw_input_dirty.reset();
+    hw_playback_dirty.reset();
+}
+
+// ── Posted commands / engine thread ──
+uint64_t MixerEngine::Post(const MixerCommand& cmd) {
+    std::lock_guard<std::mutex> lock(cmd_mtx);
+    cmd_queue.push_back(cmd);
+    cmd_queue.back().seq = ++cmd_next_seq;
+    WakeThread();
+    return cmd_next_seq;
+}
+
+void MixerEngine::WakeThread() {
+    if (thread_wake_fd < 0) return;
+    uint64_t one = 1;
+    (void)!write(thread_wake_fd, &one, sizeof(one));
+}
+
+void MixerEngine::ApplyPostedCommands() {
+    bool restart_osc = false;
+    OscPreferences restart_prefs;
+    {
+        std::lock_guard<std::mutex> lock(cmd_mtx);
+        cmd_work.swap(cmd_queue);
+        restart_osc = osc_restart_pending;
+        restart_prefs = osc_restart_prefs;
+        osc_restart_pending = false;
+    }
+    if (restart_osc) StartOsc(restart_prefs);
+    if (cmd_work.empty()) return;
+    osc_push_pending = true;
+
+    // Same batching as the OSC drain: a frame's worth of edits costs one write per touched row.
+    BeginCrosspointBatch();
+    for (const MixerCommand& cmd : cmd_work) ApplyMixerCommand(cmd);
+    CommitCrosspointBatch();
+    cmd_applied_seq = cmd_work.back().seq;
+    cmd_work.clear();
+}
+
+void MixerEngine::ApplyMixerCommand(const MixerCommand& cmd) {
+    using T = MixerCommand::Type;
+    const bool on = cmd.value != 0;
+    switch (cmd.type) {
+        case T::MasterVolume:      SetMasterVolume(cmd.channel, cmd.value); break;
+        case T::MasterMute:        SetMasterMute(cmd.channel, on); break;
+        case T::MasterSolo:        SetMasterSolo(cmd.channel, on); break;
+        case T::MasterLink:        SetMasterLink(cmd.channel, on); break;
+        case T::SourceGain:        SetSourceGain(cmd.is_playback, cmd.src, cmd.channel, cmd.value); break;
+        case T::SourceMute:        SetSourceMute(cmd.is_playback, cmd.src, cmd.channel, on); break;
+        case T::Submix:            SetSubmix(cmd.channel); break;
+        case T::HoldCrosspoint:    SetHeldCrosspoint(cmd.channel, cmd.src); break;
+        case T::ReleaseCrosspoint: ClearHeldCrosspoint(); break;
+        case T::CrosspointRaw:
+            // The Matrix grid binds to its own copy, so unlike WriteCrosspointRaw the cache is
+            // updated here.
+            if (cmd.src < 0 || cmd.src >= 18 || cmd.channel < 0 || cmd.channel >= 18) break;
+            Matrix(cmd.is_playback).gain[cmd.channel][cmd.src] = clamp_gain(cmd.value);
+            WriteCrosspointRaw(cmd.is_playback, cmd.src, cmd.channel, clamp_gain(cmd.value));
+            break;
+    }
+}
+
+void MixerEngine::PublishSnapshot() {
+    MixerSnapshot& s = snapshots.back();
+    for (int i = 0; i < 18; ++i) s.master[i] = master_states[i];
+    s.input = input_matrix;
+    s.playback = playback_matrix;
+    s.selected_output = selected_output;
+    s.osc_running = oscRunning();
+    s.osc_has_client = oscHasClient();
+    s.osc_clients = s.osc_has_client ? osc->ClientCount() : 0;
+    s.osc_received = osc_received;
+    s.osc_merged = osc_merged;
+    s.osc_dropped = osc_dropped_reported;
+    s.applied_seq = cmd_applied_seq;
+    snapshots.publish();
+}
+
+void MixerEngine::StartThread() {
+    if (threaded()) return;
+    {
+        std::lock_guard<std::mutex> lock(cmd_mtx);
+        thread_stop = false;
+    }
+    PublishSnapshot();
+    engine_thread = std::thread(&MixerEngine::ThreadMain, this);
+}
+
+void MixerEngine::StopThread() {
+    if (!threaded()) return;
+    {
+        std::lock_guard<std::mutex> lock(cmd_mtx);
+        thread_stop = true;
+        WakeThread();
+    }
+    engine_thread.join();
+}
+
+// Tick, then sleep until there is something to do: a Post() (thread_wake_fd), an inbound OSC
+// command (the server's wakeup fd), a card control event, or the next timed job. The OSC fd is
+// looked up every cycle because a deferred restart may create the server while we run. A card
+// fd that polls as an error (unplugged) is dropped for good, or every poll() would return at once.
+void MixerEngine::ThreadMain() {
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(cmd_mtx);
+            if (thread_stop) break;
+        }
+        bool busy = inputs_busy_hint.load(std::memory_order_relaxed);
+        Tick(busy);
+
+        long delay = NextTickDelayMs();
+        // A drag holds hardware reads back, so a read that is already due would spin; retry it
+        // at the tick rate instead. Without the eventfd a Post() cannot wake us: tick anyway.
+        if (busy && delay >= 0 && delay < kThreadTickMs) delay = kThreadTickMs;
+        if (thread_wake_fd < 0 && (delay < 0 || delay > kThreadTickMs)) delay = kThreadTickMs;
+        pollfd fds[3];
+        nfds_t n = 0;
+        const int card_fd = hardwareEventFd();
+        for (int fd : {thread_wake_fd, oscWakeupFd(), card_fd}) {
+            if (fd >= 0) fds[n++] = pollfd{fd, POLLIN, 0};
+        }
+        int timeout = delay < 0 ? -1 : static_cast<int>(std::max(delay, 1L));
+        if (poll(fds, n, timeout) <= 0) continue;
+        for (nfds_t i = 0; i < n; ++i) {
+            if (fds[i].fd == thread_wake_fd && (fds[i].revents & POLLIN)) {
+                uint64_t count;
+                (void)!read(thread_wake_fd, &count, sizeof(count));
+            } else if (fds[i].fd == card_fd && (fds[i].revents & (POLLERR | POLLHUP | POLLNVAL))) {
+                MarkHardwareLost();
+            }
+            // The OSC wakeup and card event fds are drained by Tick() itself.
+        }
+    }
+}
+
 // ── Service cycle ──
 void MixerEngine::Tick(bool inputs_busy) {
     auto now = steady_clock::now();
 
+    // Edits posted by a frontend (or any other thread) since the last cycle.
+    ApplyPostedCommands();
+
     // OSC inbound: apply any queued remote commands on this thread.
     if (osc && osc->IsRunning()) {
-        if (osc->TakeClientChanged()) osc_resync = true;  // new controller -> full dump
-        for (const auto& cmd : osc->DrainCommands()) ApplyOscCommand(cmd);
+        // Superseded fader values are dropped first, so a controller streaming one channel
+        // costs one primitive call per drain. One batch per drain, queued as a whole; the write
+        // queue folds it into whatever is still pending, so the burst size never sets the ALSA
+        // write rate.
+        if (osc->DrainCommands(osc_cmd_buf) > 0) osc_push_pending = external_change = true;
+        osc_received += osc_cmd_buf.size();
+        osc_merged += CoalesceOscCommands(osc_cmd_buf);
+        BeginCrosspointBatch();
+        for (const auto& cmd : osc_cmd_buf) ApplyOscCommand(cmd);
+        CommitCrosspointBatch();
+
+        // The receive thread cannot report a full queue itself; say it here, once per burst.
+        uint64_t dropped = osc->DroppedCommands();
+        if (dropped != osc_dropped_reported) {
+            std::cerr << "[OSC] command queue full: " << (dropped - osc_dropped_reported)
+                      << " command(s) dropped" << std::endl;
+            osc_dropped_reported = dropped;
+        }
     }
 
-    // Throttled hardware poll. Skip while inputs are busy (GUI drag) or right after a write.
+    // Hardware sync. Skip while inputs are busy (GUI drag) or right after a write; rows marked by
+    // control events stay queued until then. The full poll is the fallback scrubber.
+    CollectHardwareEvents();
     auto elapsed = duration_cast<milliseconds>(now - last_poll_time).count();
     auto since_write = duration_cast<milliseconds>(now - last_write_time).count();
-    bool should_skip_poll = inputs_busy || (since_write < 200);
-    if (elapsed > 500 && !should_skip_poll) {
-        PollHardware();
-        last_poll_time = now;
+    // Queued writes count as recent: the hardware has not caught up with the cache yet.
+    bool should_skip_poll = inputs_busy || (since_write < kPollAfterWriteMs) || !writes.idle();
+    if (!should_skip_poll) {
+        long full_poll_ms = hw_events ? kScrubIntervalMs : kPollIntervalMs;
+        if (elapsed > full_poll_ms) {
+            PollHardware();
+            last_poll_time = now;
+        } else {
+            PollDirtyRows();
+        }
     }
 
-    // OSC outbound: diff-push control state to the client at ~20Hz.
+    UpdateMeterSampling();
+
+    // OSC outbound: diff-push control state to the clients at ~20Hz, once something may have
+    // changed. Our own writes (any primitive) stamp last_write_time.
+    if (osc && osc->TakeFeedbackRequest()) osc_push_pending = true;
+    if (last_write_time >= last_osc_push_time) osc_push_pending = true;
     auto osc_elapsed = duration_cast<milliseconds>(now - last_osc_push_time).count();
-    if (osc_elapsed > 50) {
+    if (osc_push_pending && osc_elapsed > kOscPushIntervalMs) {
         SendOscState();
-        last_osc_push_time = now;
+        last_osc_push_time = steady_clock::now();  // after any write this cycle made
+        osc_push_pending = false;
     }
+
+    PublishSnapshot();
+    if (external_change && change_listener) change_listener();
+    external_change = false;
 }
 
 } // namespace TotalMixer
@@ -1,23 +1,34 @@
 #pragma once
 
 #include <vector>
-#include <map>
+#include <array>
+#include <bitset>
 #include <memory>
 #include <chrono>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
 #include "mixer_types.hpp"
 #include "alsa_core.hpp"
 #include "service_checker.hpp"
 #include "osc_server.hpp"
+#include "triple_buffer.hpp"
+#include "write_queue.hpp"
+#include "meter_sampler.hpp"
 
 namespace TotalMixer {
 
 // Headless mixer core: owns the ALSA connection, the mixer domain state, the shared apply
-// primitives, hardware polling, and the OSC endpoint (inbound apply + diff feedback). It has
+// primitives, hardware polling, metering, and the OSC endpoint (inbound apply + diff feedback
+// + meter streaming). It has
 // zero dependency on ImGui/GLFW/OpenGL so it can back both the GUI and a headless daemon.
 //
-// Threading: identical to the original GUI model. All mixer state lives on the caller's thread;
-// only the OSC command queue and client address cross threads (inside OscServer). Call Tick()
-// from a single thread (the GUI frame loop, or the daemon's timed loop).
+// Threading: by default all mixer state lives on the caller's thread and Tick() is called from a
+// single thread (the daemon's event loop). StartThread() instead moves the service cycle onto an
+// engine-owned thread: other threads then only Post() commands and read snapshot(), and never
+// wait on ALSA. Either way only the OSC command queue and client address cross threads inside
+// OscServer, and ALSA writes are handed to the WriteQueue worker.
 class MixerEngine {
 public:
     MixerEngine();
@@ -38,18 +49,63 @@ public:
     // card_index < 0 auto-selects the first Fireface card (the GUI default); the daemon may
     // pass an explicit index via --card.
     InitResult Init(int card_index = -1);
+    // Same, but runs on a caller-supplied backend (e.g. FakeFireface) instead of opening a card.
+    // The snd-fireface-ctl check is skipped and the service reported as running.
+    InitResult Init(std::unique_ptr<AlsaBackend> backend);
+
+    // ── Engine thread (optional) ──
+    // StartThread() runs Tick() on its own thread. It sleeps in poll() until Post(), an inbound
+    // OSC command, a card control event or the next timed job (NextTickDelayMs()). Call
+    // after Init(); call StopThread() before Init() again. Direct state access and the apply
+    // primitives below then belong to the engine thread; frontends use Post() and snapshot().
+    void StartThread();
+    void StopThread();
+    bool threaded() const { return engine_thread.joinable(); }
+    // Queue an edit for the next service cycle (any thread). Returns its sequence number, which
+    // snapshot().applied_seq reaches once it has been applied. Without the thread, the queue is
+    // drained at the start of the next Tick().
+    uint64_t Post(const MixerCommand& cmd);
+    // Drag hint for the threaded Tick (the unthreaded Tick takes it as an argument).
+    void SetInputsBusy(bool busy) { inputs_busy_hint.store(busy, std::memory_order_relaxed); }
+    // Latest state published by Tick() (single reader thread; never blocks).
+    const MixerSnapshot& snapshot() { return snapshots.front(); }
+    // Called from Tick() (the engine thread, when threaded) after publishing a snapshot that
+    // may carry changes the frontend did not post itself: inbound OSC or a hardware re-read.
+    // Lets a frontend that sleeps between frames (glfwWaitEvents) wake up for them; it must be
+    // cheap and thread-safe, e.g. glfwPostEmptyEvent. Set before StartThread().
+    void SetChangeListener(std::function<void()> fn) { change_listener = std::move(fn); }
 
     // ── OSC endpoint ──
     OscPreferences& oscPrefs() { return osc_prefs; }
     const OscPreferences& oscPrefs() const { return osc_prefs; }
-    void RestartOscServer();   // (re)start or stop per osc_prefs.enabled
+    void RestartOscServer();   // (re)start or stop per osc_prefs.enabled (deferred to the engine thread if running)
     void StopOsc();
 
-    // One service cycle: drain+apply inbound OSC, throttled hardware poll, throttled diff push.
+    // One service cycle: apply posted commands, drain+apply inbound OSC, hardware sync,
+    // throttled diff push, then publish a snapshot.
+    // Hardware sync re-reads only the rows named by ALSA control events, plus a slow full
+    // poll as a scrubber (or the original 500ms full poll when events are unavailable).
     // inputs_busy lets the GUI suppress polling while a widget is being dragged; the daemon
-    // always passes false. Meter polling is NOT done here (GUI-only, via alsa()).
+    // always passes false. Meters are not sampled here: Tick only tells the meter sampler
+    // thread whether anyone (SetMetersEnabled, an OSC meter client) wants them.
     void Tick(bool inputs_busy = false);
 
+    // ── Event loop support (unthreaded use) ──
+    // Milliseconds until Tick() has timed work to do (0 = now), or -1 if it only needs to run
+    // again on input. Input is a posted command, or one of the descriptors below polling
+    // readable. A caller that sleeps until the earlier of the two never misses work and never
+    // wakes for nothing.
+    long NextTickDelayMs() const;
+    // The card's control event descriptor (-1 without control events) and the OSC server's
+    // wakeup eventfd (-1 before OSC was first started). Tick() drains both.
+    int hardwareEventFd() const { return alsa_ && !hardwareLost() ? alsa_->event_fd() : -1; }
+    int oscWakeupFd() const { return osc ? osc->WakeupFd() : -1; }
+    // The card went away under us: its event descriptor reported an error, or the event stream
+    // failed. Sticky until the next Init(); hardwareEventFd() is -1 and metering stops meanwhile.
+    // The frontend decides how to reconnect (the daemon exits, the GUI offers a retry).
+    void MarkHardwareLost();
+    bool hardwareLost() const { return hw_lost.load(std::memory_order_relaxed); }
+
     // ── Shared apply primitives (single write path for both UI edits and OSC commands) ──
     void SetMasterVolume(int ch, long val);
     void SetMasterMute(int ch, bool mute);
@@ -68,11 +124,11 @@ public:
     int OutputLinkPartner(int ch) const;
     bool IsOutputSelected(int ch) const;
 
-    // Mutable crosspoint cache reference (inserts 0 if absent, like the original cache[{}]).
+    // Mutable crosspoint cache reference (output and src_idx must be 0-17).
     // GUI sliders bind directly to this so a drag stays smooth between throttled commits.
     long& crosspoint(bool is_playback, int output, int src_idx);
 
-    // Raw single-crosspoint write for the Matrix grid: pushes to ALSA and notes the write time
+    // Raw single-crosspoint write for the Matrix grid: queues the ALSA write and notes the time
     // but does NOT touch the cache (the caller's bound reference already holds the value), and
     // applies no link/mute semantics. Use SetSourceGain/SetSourceMute for the Mixer-view strips.
     bool WriteCrosspointRaw(bool is_playback, int src_idx, int output, long val);
@@ -86,34 +142,108 @@ public:
     // ── OSC / service status (GUI display) ──
     bool oscRunning() const;
     bool oscHasClient() const;
+    // Inbound OSC commands drained so far, how many of them were merged into a later command for
+    // the same target in the same drain, and how many never made it into the full receive queue
+    // (engine thread; the GUI reads them from the snapshot).
+    uint64_t oscReceived() const { return osc_received; }
+    uint64_t oscMerged() const { return osc_merged; }
+    uint64_t oscDropped() const { return osc_dropped_reported; }
     ServiceStatus serviceStatus() const { return service_status; }
 
     // Direct crosspoint write (analog/spdif/adat or stream), used by the primitives and the UI.
+    // Queued on the write queue; inside a crosspoint batch it is only recorded and goes out with
+    // the commit.
     bool WriteSourceGain(bool is_playback, int src_idx, int output, long val);
 
-    // GUI-only concerns (meters, arbitrary Control tab, device info) go through the ALSA handle.
-    AlsaCore* alsa() { return alsa_.get(); }
+    // ── Crosspoint batching ──
+    // Crosspoint writes between Begin and Commit are collected and handed to the write queue in
+    // one piece, so no flush can write half of them. Batches nest; only the outermost Commit
+    // queues. The source primitives batch internally. Use this around scene recalls and other
+    // bulk crosspoint changes.
+    void BeginCrosspointBatch();
+    bool CommitCrosspointBatch();
+
+    // ── ALSA write queue ──
+    // Every hardware write of mixer state goes through a queue that keeps only the latest value
+    // per control element and is flushed by its own worker at most writeRate() times a second
+    // (0 = write through on the calling thread). Safe to call from any thread.
+    void SetWriteRate(int hz) { writes.SetRate(hz); }
+    int writeRate() const { return writes.rate(); }
+    WriteQueue::Stats writeStats() const { return writes.stats(); }
+    void ResetWriteStats() { writes.ResetStats(); }
+    // Write everything queued now and wait for it (benchmarks, shutdown).
+    bool FlushWrites() { return writes.Flush(); }
+
+    // GUI-only concerns (arbitrary Control tab, device info) go through the ALSA handle.
+    AlsaBackend* alsa() { return alsa_.get(); }
     bool connected() const { return alsa_ != nullptr; }
 
     // Meter tuning is persisted alongside OSC prefs, so the engine owns it after config load.
+    // After editing meterPrefs(), ApplyMeterPrefs() hands it to the metering (any thread).
     MeterPreferences& meterPrefs() { return meter_prefs; }
     const MeterPreferences& meterPrefs() const { return meter_prefs; }
+    void ApplyMeterPrefs() {
+        meters.SetPrefs(meter_prefs);
+        meters.SetRate(meter_prefs.sample_hz);
+    }
+    // Frame pacing is a GUI setting; the engine only carries it so every save writes it back.
+    DisplayPreferences& displayPrefs() { return display_prefs; }
+
+    // ── Meters ──
+    // A frontend that displays meters turns metering on (any thread); meterFrame() then follows
+    // the hardware at meterPrefs().sample_hz. OSC meter clients turn it on by themselves.
+    void SetMetersEnabled(bool on);
+    // Latest sampled frame (single reader thread; never blocks).
+    const MeterFrame& meterFrame() { return meters.latest(); }
+    // Per-channel level history behind the latest frames (any thread).
+    const MeterHistory& meterHistory() const { return meters.history(); }
+    // Persistent overload log (recorded while metering real hardware; any thread may read it).
+    OverloadLog& overloadLog() { return meters.overloads(); }
 
 private:
     // Apply/poll internals (faithful ports of the original GUI logic).
     bool WriteAllMasterVolumes();
     void PollHardware();
-    void PollMasterVolumes();
+    void PollMasterVolumes(bool cached = false);
     void PollInputMatrix();
     void PollPlaybackMatrix();
+    void PollInputRow(int src_idx, bool cached = false);
+    void PollPlaybackRow(int src_idx, bool cached = false);
+    void CollectHardwareEvents();
+    void PollDirtyRows();
+    void ResolveControls();
+    const ControlHandle& SourceRow(bool is_playback, int src_idx) const {
+        return is_playback ? ctl_playback_rows[src_idx] : ctl_input_rows[src_idx];
+    }
+
+    MatrixState& Matrix(bool is_playback) { return is_playback ? playback_matrix : input_matrix; }
+    const MatrixState& Matrix(bool is_playback) const { return is_playback ? playback_matrix : input_matrix; }
     void CheckServiceStatus();
+    InitResult Attach(std::unique_ptr<AlsaBackend> backend);
     void ApplyOscCommand(const OscCommand& cmd);
     void SendOscState();
+    void UpdateMeterSampling();
+    void StartOsc(const OscPreferences& prefs);
+    void ApplyPostedCommands();
+    void ApplyMixerCommand(const MixerCommand& cmd);
+    void PublishSnapshot();
+    void ThreadMain();
+
+    std::unique_ptr<AlsaBackend> alsa_;
+    WriteQueue writes;  // after alsa_: stopped before the backend it writes to is destroyed
 
-    std::unique_ptr<AlsaCore> alsa_;
+    // Mixer controls resolved once per connection (and again after the card's element set
+    // changes). Every hardware read/write of mixer state goes through these.
+    ControlHandle ctl_output_volume;
+    std::array<ControlHandle, 18> ctl_input_rows;     // by global input index
+    std::array<ControlHandle, 18> ctl_playback_rows;  // by stream index
+
+    MatrixTransaction crosspoint_txn;
+    int crosspoint_batch_depth = 0;
     std::unique_ptr<OscServer> osc;
     OscPreferences osc_prefs;
     MeterPreferences meter_prefs;
+    DisplayPreferences display_prefs;
     ServiceStatus service_status = ServiceStatus::NotRunning;
 
     // Submix selection: the output (0-17) whose mix the input/playback rows currently edit.
@@ -121,26 +251,74 @@ private:
 
     // Mixer domain state.
     std::vector<ChannelState> master_states;                 // 18 masters
-    std::map<std::pair<int, int>, long> input_matrix_cache;  // (out, src) -> gain
-    std::map<std::pair<int, int>, long> playback_matrix_cache;
-    std::map<std::pair<int, int>, long> input_mute_state;    // present == muted; value = saved gain
-    std::map<std::pair<int, int>, long> playback_mute_state;
+    MatrixState input_matrix;     // by global input index
+    MatrixState playback_matrix;  // by stream index
 
     std::vector<std::chrono::steady_clock::time_point> master_last_write_time;
     std::chrono::steady_clock::time_point last_write_time;
     std::chrono::steady_clock::time_point last_poll_time;
 
-    // OSC diff-push snapshots (sentinel -1 forces a first send; resync overrides).
+    // Event-driven hardware sync: rows named by control events wait here until polling is
+    // allowed (no drag, no recent write of ours). hw_rescan asks for a full poll instead,
+    // after elements were added/removed or the event stream is otherwise untrustworthy.
+    bool hw_events = false;
+    bool hw_rescan = false;
+    std::atomic<bool> hw_lost{false};
+    bool hw_master_dirty = false;
+    std::bitset<18> hw_input_dirty;     // by global input index (analog 0-7, spdif 8-9, adat 10-17)
+    std::bitset<18> hw_playback_dirty;  // by stream index
+    std::vector<ControlEvent> hw_event_buf;
+
+    // Feedback addresses, encoded once at construction; SendOscState only patches the values.
+    struct OscFeedbackAddresses {
+        OscFloatMessage submix_current;
+        std::array<OscFloatMessage, 18> out_fader, out_mute, out_solo, out_link;
+        std::array<OscFloatMessage, 18> in_fader, in_mute, pb_fader, pb_mute;
+        // [output][source]
+        std::array<std::array<OscFloatMessage, 18>, 18> mix_in_fader, mix_in_mute, mix_pb_fader, mix_pb_mute;
+    };
+    OscFeedbackAddresses osc_addr;
+
+    // OSC feedback push timing and inbound counters. Per-client diff state lives in OscServer.
+    // A push is only due after something may have changed (or a client asked for feedback).
     std::chrono::steady_clock::time_point last_osc_push_time;
-    bool osc_resync = true;
-    int osc_last_sent_submix = -1;
-    std::vector<long> osc_last_out_fader, osc_last_in_fader, osc_last_pb_fader;
-    std::vector<int> osc_last_out_mute, osc_last_out_solo, osc_last_out_link,
-                     osc_last_in_mute, osc_last_pb_mute;
+    bool osc_push_pending = true;
+    uint64_t osc_received = 0;
+    uint64_t osc_merged = 0;
+    uint64_t osc_dropped_reported = 0;   // OscServer::DroppedCommands() at the last check
+    std::vector<OscCommand> osc_cmd_buf; // drain buffer, reused every Tick
+
+    // Metering runs on the sampler's thread. It streams frames straight to meter_osc (the OSC
+    // server once created; it is never destroyed before the sampler stops), packed into
+    // meter_blob, which only the sampler thread touches.
+    MeterSampler meters;
+    std::atomic<bool> meters_enabled{false};
+    std::atomic<OscServer*> meter_osc{nullptr};
+    std::array<uint8_t, MeterBank::kBlobBytes> meter_blob{};
 
     // Held crosspoint hint (GUI drag protection).
     std::pair<int, int> held_cell{0, 0};
     bool has_held_cell = false;
+
+    // Posted commands (cmd_queue, guarded by cmd_mtx) are swapped into cmd_work by the service
+    // cycle. A deferred OSC restart travels with a copy of the prefs it was requested with.
+    // thread_wake_fd is an eventfd the engine thread polls; WakeThread() makes it readable.
+    void WakeThread();
+    std::mutex cmd_mtx;
+    int thread_wake_fd = -1;
+    std::vector<MixerCommand> cmd_queue;
+    std::vector<MixerCommand> cmd_work;
+    uint64_t cmd_next_seq = 0;
+    uint64_t cmd_applied_seq = 0;
+    bool osc_restart_pending = false;
+    OscPreferences osc_restart_prefs;
+
+    std::thread engine_thread;
+    bool thread_stop = false;  // guarded by cmd_mtx
+    std::atomic<bool> inputs_busy_hint{false};
+    std::function<void()> change_listener;
+    bool external_change = false;  // this Tick applied OSC commands or re-read the hardware
+    TripleBuffer<MixerSnapshot> snapshots;
 };
 
 } // namespace TotalMixer
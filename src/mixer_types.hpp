@@ -2,8 +2,12 @@
 
 // GUI-free plain-data types shared between the mixer engine (headless-safe) and the
 // GUI frontend. Nothing here may depend on ImGui/GLFW/OpenGL so that libmixer_engine
-// links without any X11/GL toolchain. GUI-only view types (MeterLevel, Device_Info,
-// ConnectionStatus) intentionally stay in gui_app.hpp.
+// links without any X11/GL toolchain. GUI-only view types (Device_Info, ConnectionStatus)
+// intentionally stay in gui_app.hpp.
+
+#include <array>
+#include <bitset>
+#include <cstdint>
 
 namespace TotalMixer {
 
@@ -16,13 +20,67 @@ struct ChannelState {
     long saved_value = 0;
 };
 
-// Meter display tuning (persisted in preferences.json under "meters"). The engine does
-// not consume these, but it owns config load/save so the type must be GUI-free.
+// Crosspoint state of one source bank (hardware inputs or playback streams), stored flat and
+// indexed [output][src] so the selected submix is one contiguous row.
+struct MatrixState {
+    std::array<std::array<long, 18>, 18> gain{};   // last known hardware gain
+    std::array<std::array<long, 18>, 18> saved{};  // gain to restore on unmute (valid while muted)
+    std::array<std::bitset<18>, 18> muted;         // bit src of muted[out]
+};
+
+// One meter channel after ballistics (computed by MeterBank).
+struct MeterLevel {
+    float normalized = 0.0f;       // Current level normalized to [0.0, 1.0]
+    float rms_normalized = 0.0f;   // RMS level normalized to [0.0, 1.0]
+    float peak_norm = 0.0f;        // Peak normalized value (for hold)
+    bool is_overload = false;      // OVR flag
+};
+
+// Immutable copy of the engine's mixer state, published after every engine service cycle so a
+// frontend on another thread can render it without locking.
+struct MixerSnapshot {
+    std::array<ChannelState, 18> master;
+    MatrixState input;     // by global input index
+    MatrixState playback;  // by stream index
+    int selected_output = 0;
+    bool osc_running = false;
+    bool osc_has_client = false;
+    size_t osc_clients = 0;     // controllers in the OSC client table
+    uint64_t osc_received = 0;  // inbound OSC commands drained since startup
+    uint64_t osc_merged = 0;    // ... of which were superseded within their drain and skipped
+    uint64_t osc_dropped = 0;   // lost to a full receive queue
+    uint64_t applied_seq = 0;  // sequence number of the last MixerCommand applied
+
+    const MatrixState& matrix(bool is_playback) const { return is_playback ? playback : input; }
+    MatrixState& matrix(bool is_playback) { return is_playback ? playback : input; }
+};
+
+// One edit posted to the engine from another thread; mirrors the engine's apply primitives.
+struct MixerCommand {
+    enum class Type {
+        MasterVolume, MasterMute, MasterSolo, MasterLink,
+        SourceGain, SourceMute,
+        CrosspointRaw,           // single crosspoint, no link/mute semantics (Matrix grid)
+        Submix,
+        HoldCrosspoint, ReleaseCrosspoint
+    };
+    Type type = Type::MasterVolume;
+    bool is_playback = false;
+    int channel = 0;   // master channel, or output for source/crosspoint commands
+    int src = 0;       // source row for source/crosspoint commands
+    long value = 0;    // gain, or 0/1 for toggles
+    uint64_t seq = 0;  // assigned by MixerEngine::Post
+};
+
+// Meter tuning (persisted in preferences.json under "meters"): ballistics, sampling rate and
+// history length, applied by the engine's meter sampler.
 struct MeterPreferences {
     int ovr_sample_count = 3;       // Consecutive overload samples for OVR (1-10)
     float peak_hold_seconds = 1.5f; // Peak hold duration (0.1-9.9s)
     bool rms_plus_3db = false;      // RMS +3dB correction checkbox
     float rms_tau_seconds = 0.3f;   // RMS integration time (0.05-1.0s)
+    int sample_hz = 30;             // Meter sampling rate (10-100 Hz)
+    int history_seconds = 10;       // Level history kept per channel (2-120s)
 };
 
 // OSC remote endpoint settings (persisted in preferences.json under "osc").
@@ -32,4 +90,10 @@ struct OscPreferences {
     int out_port = 9001;    // UDP port we send state feedback to (on the client host)
 };
 
+// GUI frame pacing (persisted in preferences.json under "display"; the daemon ignores it).
+struct DisplayPreferences {
+    int active_fps = 60;    // Frame cap while interacting or while meters move (10-240)
+    int idle_fps = 2;       // Redraw rate when nothing changes (0-30, 0 = on input/engine change only)
+};
+
 } // namespace TotalMixer
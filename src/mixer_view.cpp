@@ -0,0 +1,285 @@
+#include "mixer_view.hpp"
+#include <algorithm>
+
+namespace TotalMixer {
+
+static inline long clamp_gain(long v) { return v < 0 ? 0 : (v > 65536 ? 65536 : v); }
+
+static int LinkPartner(const MixerSnapshot& s, int ch) {
+    if (ch < 0 || ch >= 18 || !s.master[ch].is_linked) return -1;
+    int partner = (ch % 2 == 0) ? ch + 1 : ch - 1;
+    return (partner >= 0 && partner < 18) ? partner : -1;
+}
+
+MixerView::MixerView(MixerEngine& engine) : engine(engine), meters(&engine.meterFrame()) {}
+
+int MixerView::OutputLinkPartner(int ch) const {
+    return LinkPartner(view, ch);
+}
+
+bool MixerView::IsOutputSelected(int ch) const {
+    if (ch == view.selected_output) return true;
+    int partner = LinkPartner(view, view.selected_output);
+    return (partner != -1 && ch == partner);
+}
+
+void MixerView::Sync() {
+    // Keep what the held widget currently shows (a linked master drags its partner along).
+    ChannelState held_master, held_partner;
+    int partner = -1;
+    long held_gain = 0;
+    if (held.kind == Held::Kind::Master) {
+        held_master = view.master[held.output];
+        partner = LinkPartner(view, held.output);
+        if (partner != -1) held_partner = view.master[partner];
+    } else if (held.kind == Held::Kind::Crosspoint) {
+        held_gain = view.matrix(held.is_playback).gain[held.output][held.src];
+    }
+
+    view = engine.snapshot();
+    meters = &engine.meterFrame();
+    uint64_t applied = view.applied_seq;
+    in_flight.erase(std::remove_if(in_flight.begin(), in_flight.end(),
+                                   [applied](const MixerCommand& c) { return c.seq <= applied; }),
+                    in_flight.end());
+    for (const MixerCommand& cmd : in_flight) Preview(view, cmd);
+
+    if (held.kind == Held::Kind::Master) {
+        view.master[held.output].value = held_master.value;
+        if (partner != -1) view.master[partner].value = held_partner.value;
+    } else if (held.kind == Held::Kind::Crosspoint) {
+        view.matrix(held.is_playback).gain[held.output][held.src] = held_gain;
+    }
+}
+
+// ── Edits ──
+void MixerView::Edit(MixerCommand cmd) {
+    cmd.seq = engine.Post(cmd);
+    Preview(view, cmd);
+    in_flight.push_back(cmd);
+    if (Targets(cmd)) {
+        held.last_edit = cmd;
+        held.has_edit = true;
+    }
+}
+
+void MixerView::SetMasterVolume(int ch, long val) {
+    MixerCommand c;
+    c.type = MixerCommand::Type::MasterVolume;
+    c.channel = ch;
+    c.value = val;
+    Edit(c);
+}
+
+void MixerView::SetMasterMute(int ch, bool mute) {
+    MixerCommand c;
+    c.type = MixerCommand::Type::MasterMute;
+    c.channel = ch;
+    c.value = mute ? 1 : 0;
+    Edit(c);
+}
+
+void MixerView::SetMasterSolo(int ch, bool solo) {
+    MixerCommand c;
+    c.type = MixerCommand::Type::MasterSolo;
+    c.channel = ch;
+    c.value = solo ? 1 : 0;
+    Edit(c);
+}
+
+void MixerView::SetMasterLink(int ch, bool linked) {
+    MixerCommand c;
+    c.type = MixerCommand::Type::MasterLink;
+    c.channel = ch;
+    c.value = linked ? 1 : 0;
+    Edit(c);
+}
+
+void MixerView::SetSourceGain(bool is_playback, int src_idx, int output, long val) {
+    MixerCommand c;
+    c.type = MixerCommand::Type::SourceGain;
+    c.is_playback = is_playback;
+    c.channel = output;
+    c.src = src_idx;
+    c.value = val;
+    Edit(c);
+}
+
+void MixerView::SetSourceMute(bool is_playback, int src_idx, int output, bool mute) {
+    MixerCommand c;
+    c.type = MixerCommand::Type::SourceMute;
+    c.is_playback = is_playback;
+    c.channel = output;
+    c.src = src_idx;
+    c.value = mute ? 1 : 0;
+    Edit(c);
+}
+
+void MixerView::SetSubmix(int output) {
+    MixerCommand c;
+    c.type = MixerCommand::Type::Submix;
+    c.channel = output;
+    Edit(c);
+}
+
+void MixerView::WriteCrosspointRaw(bool is_playback, int src_idx, int output, long val) {
+    MixerCommand c;
+    c.type = MixerCommand::Type::CrosspointRaw;
+    c.is_playback = is_playback;
+    c.channel = output;
+    c.src = src_idx;
+    c.value = val;
+    Edit(c);
+}
+
+// Local copy of what the engine primitive will do to the state, so the frame after an edit
+// already shows its effect. The engine's result replaces it as soon as a snapshot includes it.
+void MixerView::Preview(MixerSnapshot& s, const MixerCommand& cmd) {
+    using T = MixerCommand::Type;
+    const bool on = cmd.value != 0;
+    const int ch = cmd.channel;
+    if (ch < 0 || ch >= 18) return;
+    const int partner = LinkPartner(s, ch);
+
+    switch (cmd.type) {
+        case T::MasterVolume: {
+            long v = clamp_gain(cmd.value);
+            for (int c : {ch, partner}) {
+                if (c < 0) continue;
+                s.master[c].value = v;
+                s.master[c].is_muted = false;
+            }
+            break;
+        }
+        case T::MasterMute:
+            if (s.master[ch].is_muted == on) break;
+            for (int c : {ch, partner}) {
+                if (c < 0) continue;
+                ChannelState& m = s.master[c];
+                if (on) {
+                    m.is_muted = true;
+                    m.saved_value = m.value;
+                    m.value = 0;
+                } else {
+                    m.is_muted = false;
+                    m.value = clamp_gain(m.saved_value);
+                }
+            }
+            break;
+        case T::MasterSolo:
+            s.master[ch].is_soloed = on;
+            if (partner != -1) s.master[partner].is_soloed = on;
+            break;
+        case T::MasterLink: {
+            int pair = (ch % 2 == 0) ? ch + 1 : ch - 1;
+            s.master[ch].is_linked = on;
+            if (pair >= 0 && pair < 18) s.master[pair].is_linked = on;
+            break;
+        }
+        case T::SourceGain: {
+            if (cmd.src < 0 || cmd.src >= 18) break;
+            MatrixState& m = s.matrix(cmd.is_playback);
+            long v = clamp_gain(cmd.value);
+            if (v > 0) m.muted[ch].reset(cmd.src);
+            m.gain[ch][cmd.src] = v;
+            if (partner != -1) m.gain[partner][cmd.src] = v;
+            break;
+        }
+        case T::SourceMute: {
+            if (cmd.src < 0 || cmd.src >= 18) break;
+            MatrixState& m = s.matrix(cmd.is_playback);
+            if (m.muted[ch].test(cmd.src) == on) break;
+            long v = 0;
+            if (on) {
+                m.muted[ch].set(cmd.src);
+                m.saved[ch][cmd.src] = m.gain[ch][cmd.src];
+            } else {
+                m.muted[ch].reset(cmd.src);
+                v = m.saved[ch][cmd.src];
+            }
+            m.gain[ch][cmd.src] = v;
+            if (partner != -1) m.gain[partner][cmd.src] = v;
+            break;
+        }
+        case T::CrosspointRaw:
+            if (cmd.src < 0 || cmd.src >= 18) break;
+            s.matrix(cmd.is_playback).gain[ch][cmd.src] = clamp_gain(cmd.value);
+            break;
+        case T::Submix:
+            s.selected_output = ch;
+            break;
+        case T::HoldCrosspoint:
+        case T::ReleaseCrosspoint:
+            break;
+    }
+}
+
+// ── Held widget ──
+void MixerView::HoldCrosspoint(bool is_playback, int output, int src_idx) {
+    if (isHeldCrosspoint(is_playback, output, src_idx)) return;
+    ReleaseHeld();
+    held.kind = Held::Kind::Crosspoint;
+    held.is_playback = is_playback;
+    held.output = output;
+    held.src = src_idx;
+
+    MixerCommand c;
+    c.type = MixerCommand::Type::HoldCrosspoint;
+    c.channel = output;
+    c.src = src_idx;
+    engine.Post(c);
+}
+
+void MixerView::HoldMaster(int ch) {
+    if (isHeldMaster(ch)) return;
+    ReleaseHeld();
+    held.kind = Held::Kind::Master;
+    held.output = ch;
+}
+
+bool MixerView::isHeldCrosspoint(bool is_playback, int output, int src_idx) const {
+    return held.kind == Held::Kind::Crosspoint && held.is_playback == is_playback &&
+           held.output == output && held.src == src_idx;
+}
+
+bool MixerView::isHeldMaster(int ch) const {
+    return held.kind == Held::Kind::Master && held.output == ch;
+}
+
+long MixerView::HeldValue() const {
+    if (held.kind == Held::Kind::Master) return view.master[held.output].value;
+    return view.matrix(held.is_playback).gain[held.output][held.src];
+}
+
+bool MixerView::Targets(const MixerCommand& cmd) const {
+    using T = MixerCommand::Type;
+    if (held.kind == Held::Kind::Master) {
+        return cmd.type == T::MasterVolume && cmd.channel == held.output;
+    }
+    if (held.kind == Held::Kind::Crosspoint) {
+        return (cmd.type == T::SourceGain || cmd.type == T::CrosspointRaw) &&
+               cmd.is_playback == held.is_playback && cmd.channel == held.output && cmd.src == held.src;
+    }
+    return false;
+}
+
+void MixerView::ReleaseHeld() {
+    if (held.kind == Held::Kind::None) return;
+
+    // Input throttling may have dropped the last few drag positions; make sure the value the
+    // widget was let go at is the one that reaches the engine.
+    if (held.has_edit && held.last_edit.value != HeldValue()) {
+        MixerCommand c = held.last_edit;
+        c.value = HeldValue();
+        held.has_edit = false;
+        Edit(c);
+    }
+    if (held.kind == Held::Kind::Crosspoint) {
+        MixerCommand c;
+        c.type = MixerCommand::Type::ReleaseCrosspoint;
+        engine.Post(c);
+    }
+    held = Held{};
+}
+
+} // namespace TotalMixer
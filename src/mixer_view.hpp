@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vector>
+#include "mixer_types.hpp"
+#include "mixer_engine.hpp"
+
+namespace TotalMixer {
+
+// Frontend-side view of a MixerEngine running on its own thread. Sync() copies the engine's
+// latest snapshot once per frame and replays on top of it the edits this view has posted but the
+// engine has not applied yet, so a value never jumps back while its command is in flight.
+// Widgets bind to the view's storage the same way they used to bind to the engine's caches, and
+// edits go out through MixerEngine::Post(). The widget being dragged (held) keeps its local value
+// across Sync(); releasing it posts the final value if the last posted one is behind.
+//
+// Frontend thread only. GUI-free, like the engine.
+class MixerView {
+public:
+    explicit MixerView(MixerEngine& engine);
+
+    // Pull the latest snapshot. Call once per frame, before drawing.
+    void Sync();
+
+    // ── State (bindable) ──
+    ChannelState& master(int ch) { return view.master[ch]; }
+    const ChannelState& master(int ch) const { return view.master[ch]; }
+    int selectedOutput() const { return view.selected_output; }
+    long& crosspoint(bool is_playback, int output, int src_idx) { return view.matrix(is_playback).gain[output][src_idx]; }
+    bool sourceMuted(bool is_playback, int output, int src_idx) const { return view.matrix(is_playback).muted[output].test(src_idx); }
+    int OutputLinkPartner(int ch) const;
+    bool IsOutputSelected(int ch) const;
+    bool oscRunning() const { return view.osc_running; }
+    bool oscHasClient() const { return view.osc_has_client; }
+    size_t oscClients() const { return view.osc_clients; }
+    uint64_t oscReceived() const { return view.osc_received; }
+    uint64_t oscMerged() const { return view.osc_merged; }
+    uint64_t oscDropped() const { return view.osc_dropped; }
+    // Meters come from the sampler's latest frame (picked up by Sync), not from the snapshot.
+    const MeterFrame& meterFrame() const { return *meters; }
+    const MeterLevel& outputMeter(int ch) const { return meters->levels[MeterBank::kOutputBase + ch]; }
+    const MeterLevel& inputMeter(int src_idx) const { return meters->levels[MeterBank::kInputBase + src_idx]; }
+    const MeterLevel& playbackMeter(int src_idx) const { return meters->levels[MeterBank::kPlaybackBase + src_idx]; }
+
+    // ── Edits (same semantics as the engine primitives of the same name) ──
+    void SetMasterVolume(int ch, long val);
+    void SetMasterMute(int ch, bool mute);
+    void SetMasterSolo(int ch, bool solo);
+    void SetMasterLink(int ch, bool linked);
+    void SetSourceGain(bool is_playback, int src_idx, int output, long val);
+    void SetSourceMute(bool is_playback, int src_idx, int output, bool mute);
+    void SetSubmix(int output);
+    void WriteCrosspointRaw(bool is_playback, int src_idx, int output, long val);
+
+    // ── Held widget ──
+    // Holding a crosspoint also tells the engine, so hardware polling leaves that cell alone.
+    void HoldCrosspoint(bool is_playback, int output, int src_idx);
+    void HoldMaster(int ch);
+    bool isHeldCrosspoint(bool is_playback, int output, int src_idx) const;
+    bool isHeldMaster(int ch) const;
+    void ReleaseHeld();
+
+private:
+    struct Held {
+        enum class Kind { None, Master, Crosspoint };
+        Kind kind = Kind::None;
+        bool is_playback = false;
+        int output = 0;  // master channel for Kind::Master
+        int src = 0;
+        bool has_edit = false;
+        MixerCommand last_edit;  // last edit posted for the held target
+    };
+
+    MixerEngine& engine;
+    MixerSnapshot view;
+    const MeterFrame* meters;  // valid until the next Sync()
+    std::vector<MixerCommand> in_flight;  // posted, not yet in a snapshot
+    Held held;
+
+    void Edit(MixerCommand cmd);
+    long HeldValue() const;
+    bool Targets(const MixerCommand& cmd) const;
+    static void Preview(MixerSnapshot& s, const MixerCommand& cmd);
+};
+
+} // namespace TotalMixer
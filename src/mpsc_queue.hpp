@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace TotalMixer {
+
+// Bounded multi-producer / single-consumer queue over a fixed ring of preallocated slots.
+// Producers claim a slot with one CAS on the tail and publish it through the slot's sequence
+// number, so push() never blocks and never allocates; when the ring is full the item is dropped
+// and counted instead. The single consumer pops without any read-modify-write at all.
+//
+// Capacity must be a power of two.
+template <typename T, size_t Capacity>
+class MpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    MpscQueue() {
+        for (size_t i = 0; i < Capacity; ++i) slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    static constexpr size_t capacity() { return Capacity; }
+
+    // Any thread. Returns false (and counts the drop) if the queue is full.
+    bool push(const T& value) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& s = slots[pos & kMask];
+            size_t seq = s.seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                dropped_count.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+        Slot& s = slots[pos & kMask];
+        s.value = value;
+        s.seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only. Returns false when nothing (more) is published.
+    bool pop(T& out) {
+        Slot& s = slots[head & kMask];
+        if (s.seq.load(std::memory_order_acquire) != head + 1) return false;
+        out = s.value;
+        s.seq.store(head + Capacity, std::memory_order_release);
+        ++head;
+        return true;
+    }
+
+    // Items rejected because the queue was full, since construction.
+    uint64_t dropped() const { return dropped_count.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t kMask = Capacity - 1;
+
+    struct Slot {
+        std::atomic<size_t> seq{0};
+        T value{};
+    };
+
+    std::array<Slot, Capacity> slots;
+    alignas(64) std::atomic<size_t> tail{0};  // next slot a producer claims
+    alignas(64) size_t head = 0;              // consumer-owned
+    std::atomic<uint64_t> dropped_count{0};
+};
+
+} // namespace TotalMixer
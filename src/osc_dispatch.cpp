@@ -0,0 +1,120 @@
+#include "osc_dispatch.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace TotalMixer {
+
+namespace {
+
+constexpr size_t kMaxPath = 24;   // longest address is "/mix/18/pb/fader/18" (19 chars)
+constexpr size_t kSlots = 4096;   // power of two, ~3x the address count
+
+// FNV-1a.
+uint32_t Hash(const char* s, size_t len) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; ++i) {
+        h ^= static_cast<unsigned char>(s[i]);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+struct Entry {
+    char path[kMaxPath] = {};
+    uint8_t len = 0;              // 0 = empty slot
+    OscCmdType type = OscCmdType::Unknown;
+    int index = 0;
+    int output = 0;
+};
+
+struct Table {
+    std::array<Entry, kSlots> slots;
+
+    Table() {
+        struct Group { const char* prefix; OscCmdType type; };
+        static const Group groups[] = {
+            {"/out/fader/",    OscCmdType::OutFader},
+            {"/out/mute/",     OscCmdType::OutMute},
+            {"/out/solo/",     OscCmdType::OutSolo},
+            {"/out/link/",     OscCmdType::OutLink},
+            {"/in/fader/",     OscCmdType::InFader},
+            {"/in/mute/",      OscCmdType::InMute},
+            {"/pb/fader/",     OscCmdType::PbFader},
+            {"/pb/mute/",      OscCmdType::PbMute},
+            {"/submix/select/", OscCmdType::SubmixSelect},
+        };
+        char buf[kMaxPath];
+        for (const Group& g : groups) {
+            for (int n = 1; n <= 18; ++n) {
+                std::snprintf(buf, sizeof(buf), "%s%d", g.prefix, n);
+                Insert(buf, g.type, n - 1);
+            }
+        }
+        // /mix/<output>/{in,pb}/{fader,mute}/<source>
+        static const Group mix_groups[] = {
+            {"in/fader/", OscCmdType::MixInFader},
+            {"in/mute/",  OscCmdType::MixInMute},
+            {"pb/fader/", OscCmdType::MixPbFader},
+            {"pb/mute/",  OscCmdType::MixPbMute},
+        };
+        for (const Group& g : mix_groups) {
+            for (int out = 1; out <= 18; ++out) {
+                for (int n = 1; n <= 18; ++n) {
+                    std::snprintf(buf, sizeof(buf), "/mix/%d/%s%d", out, g.prefix, n);
+                    Insert(buf, g.type, n - 1, out - 1);
+                }
+            }
+        }
+        Insert("/query", OscCmdType::QueryAll, 0);
+        // index = OscFamily bit number
+        Insert("/subscribe/out",    OscCmdType::Subscribe, 0);
+        Insert("/subscribe/in",     OscCmdType::Subscribe, 1);
+        Insert("/subscribe/pb",     OscCmdType::Subscribe, 2);
+        Insert("/subscribe/submix", OscCmdType::Subscribe, 3);
+        Insert("/subscribe/mix",    OscCmdType::Subscribe, 4);
+        Insert("/meters/rate",      OscCmdType::MeterRate, 0);
+    }
+
+    void Insert(const char* path, OscCmdType type, int index, int output = 0) {
+        size_t len = std::strlen(path);
+        size_t i = Hash(path, len) & (kSlots - 1);
+        while (slots[i].len != 0) i = (i + 1) & (kSlots - 1);
+        Entry& e = slots[i];
+        std::memcpy(e.path, path, len);
+        e.len = static_cast<uint8_t>(len);
+        e.type = type;
+        e.index = index;
+        e.output = output;
+    }
+};
+
+const Table& GetTable() {
+    static const Table table;
+    return table;
+}
+
+} // namespace
+
+bool LookupOscAddress(const char* path, OscCommand& cmd) {
+    if (!path) return false;
+    // Anything longer than the longest address cannot match; don't scan past that.
+    size_t len = strnlen(path, kMaxPath);
+    if (len >= kMaxPath) return false;
+
+    const Table& t = GetTable();
+    for (size_t i = Hash(path, len) & (kSlots - 1);; i = (i + 1) & (kSlots - 1)) {
+        const Entry& e = t.slots[i];
+        if (e.len == 0) return false;
+        if (e.len == len && std::memcmp(e.path, path, len) == 0) {
+            cmd.type = e.type;
+            cmd.index = e.index;
+            cmd.output = e.output;
+            return true;
+        }
+    }
+}
+
+} // namespace TotalMixer
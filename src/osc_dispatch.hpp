@@ -0,0 +1,18 @@
+#pragma once
+
+#include "osc_server.hpp"
+
+namespace TotalMixer {
+
+// Inbound OSC address lookup. Every address the mixer accepts (/out/{fader,mute,solo,link}/N,
+// /in/{fader,mute}/N, /pb/{fader,mute}/N, /submix/select/N for N = 1-18,
+// /mix/O/{in,pb}/{fader,mute}/N for every crosspoint, /query, /subscribe/<family> and
+// /meters/rate) is compiled once into an open-addressing hash table; resolving a path is one hash pass over it
+// plus a compare against the matching slot, with no heap allocation and no tokenizing. Safe to
+// call from any thread.
+//
+// Returns false for any other address. On a match, sets cmd's type, index and output (0-based;
+// index is 0 for /query and the OscFamily bit number for /subscribe/*); value is left alone.
+bool LookupOscAddress(const char* path, OscCommand& cmd);
+
+} // namespace TotalMixer
@@ -1,8 +1,16 @@
 #include "osc_server.hpp"
+#include "osc_dispatch.hpp"
 
 #include <lo/lo.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <iostream>
-#include <cstdlib>
 
 namespace TotalMixer {
 
@@ -13,42 +21,16 @@ static void osc_err_handler(int num, const char* msg, const char* where) {
               << " (" << (where ? where : "") << ")" << std::endl;
 }
 
-static OscCmdType map_type(const std::string& g, const std::string& c) {
-    if (g == "out") {
-        if (c == "fader") return OscCmdType::OutFader;
-        if (c == "mute")  return OscCmdType::OutMute;
-        if (c == "solo")  return OscCmdType::OutSolo;
-        if (c == "link")  return OscCmdType::OutLink;
-    } else if (g == "in") {
-        if (c == "fader") return OscCmdType::InFader;
-        if (c == "mute")  return OscCmdType::InMute;
-    } else if (g == "pb") {
-        if (c == "fader") return OscCmdType::PbFader;
-        if (c == "mute")  return OscCmdType::PbMute;
-    } else if (g == "submix") {
-        if (c == "select") return OscCmdType::SubmixSelect;
-    }
-    return OscCmdType::Unknown;
-}
-
-// Catch-all handler: runs on the liblo server thread. Parses "/group/control/N" + one numeric
-// argument into an OscCommand and hands it to the OscServer instance (user pointer).
+// Catch-all handler: runs on the liblo server thread. Resolves the address through the dispatch
+// table, reads one numeric argument, and hands the OscCommand to the OscServer instance (user
+// pointer). Nothing here allocates.
 static int osc_handler(const char* path, const char* types, lo_arg** argv, int argc,
                        lo_message msg, void* user) {
     OscServer* self = static_cast<OscServer*>(user);
     if (!self || !path) return 0;
 
-    // Tokenize the path by '/'.
-    std::vector<std::string> tok;
-    {
-        std::string cur;
-        for (const char* p = path; *p; ++p) {
-            if (*p == '/') { if (!cur.empty()) { tok.push_back(cur); cur.clear(); } }
-            else cur += *p;
-        }
-        if (!cur.empty()) tok.push_back(cur);
-    }
-    if (tok.empty()) return 0;
+    OscCommand cmd;
+    if (!LookupOscAddress(path, cmd)) return 0;
 
     // First argument -> float (accept several numeric/bool OSC types defensively).
     float v = 0.0f;
@@ -63,29 +45,63 @@ static int osc_handler(const char* path, const char* types, lo_arg** argv, int a
             default: break;
         }
     }
-
-    OscCommand cmd;
     cmd.value = v;
-    if (tok[0] == "query") {
-        cmd.type = OscCmdType::QueryAll;
-    } else if (tok.size() >= 3) {
-        cmd.type = map_type(tok[0], tok[1]);
-        cmd.index = atoi(tok[2].c_str()) - 1;  // 1-based path -> 0-based index
-    }
-    if (cmd.type == OscCmdType::Unknown) return 0;
 
     const char* host = nullptr;
     lo_address src = lo_message_get_source(msg);
     if (src) host = lo_address_get_hostname(src);
-    self->EnqueueCommand(cmd, host);
+    if (cmd.type == OscCmdType::QueryAll || cmd.type == OscCmdType::Subscribe ||
+        cmd.type == OscCmdType::MeterRate) {
+        self->HandleClientCommand(cmd, host);
+    } else {
+        self->EnqueueCommand(cmd, host);
+    }
     return 0;
 }
 
+// ── OscFloatMessage ────────────────────────────────────────────────────────
+
+static inline size_t Pad4(size_t n) { return (n + 3) & ~size_t(3); }
+
+OscFloatMessage::OscFloatMessage(const std::string& path, uint32_t family, uint32_t slot)
+    : path_(path), family_(family), slot_(slot) {
+    // OSC strings are NUL-terminated and zero-padded to a multiple of 4 bytes.
+    size_t path_bytes = Pad4(path.size() + 1);
+    encoded_.assign(path_bytes + 4 + 4, 0);
+    std::memcpy(encoded_.data(), path.data(), path.size());
+    std::memcpy(encoded_.data() + path_bytes, ",f", 2);
+}
+
+void OscFloatMessage::Encode(float value, char* out) const {
+    size_t n = encoded_.size();
+    std::memcpy(out, encoded_.data(), n - 4);
+    uint32_t bits;
+    std::memcpy(&bits, &value, 4);
+    bits = htonl(bits);
+    std::memcpy(out + n - 4, &bits, 4);
+}
+
 // ── OscServer ──────────────────────────────────────────────────────────────
 
-OscServer::OscServer() {}
+OscServer::Client::~Client() {
+    if (fd >= 0) close(fd);
+}
+
+OscServer::OscServer() {
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+}
 
-OscServer::~OscServer() { Stop(); }
+OscServer::~OscServer() {
+    Stop();
+    if (wake_fd_ >= 0) close(wake_fd_);
+}
+
+// Any thread. Only the first wake after a drain costs a syscall.
+void OscServer::Wake() {
+    if (wake_fd_ < 0 || !wake_armed_.exchange(false, std::memory_order_acq_rel)) return;
+    uint64_t one = 1;
+    (void)!write(wake_fd_, &one, sizeof(one));
+}
 
 bool OscServer::Start(int in_port, int out_port) {
     if (running_.load()) Stop();
@@ -119,57 +135,257 @@ void OscServer::Stop() {
     }
     {
         std::lock_guard<std::mutex> lk(client_mtx_);
-        if (client_) { lo_address_free((lo_address)client_); client_ = nullptr; }
-        client_host_.clear();
+        clients_.clear();
+        rx_last_ = nullptr;
     }
-    {
-        std::lock_guard<std::mutex> lk(queue_mtx_);
-        std::queue<OscCommand> empty;
-        std::swap(queue_, empty);
+    // The receive thread is gone; discard whatever it left behind, wakeup included, so the fd
+    // does not stay readable for a loop that no longer drains it.
+    std::vector<OscCommand> stale;
+    DrainCommands(stale);
+}
+
+// ── Client table ──
+
+// Receive thread. Finds (or registers) the sender and stamps it as seen. A run of messages from
+// the same client never takes the lock.
+OscServer::Client* OscServer::Touch(const char* host) {
+    if (!host || !*host) return nullptr;
+    Client* c = rx_last_;
+    if (!c || c->host != host) {
+        std::lock_guard<std::mutex> lk(client_mtx_);
+        c = nullptr;
+        for (auto& known : clients_) {
+            if (known->host == host) { c = known.get(); break; }
+        }
+        if (!c) c = AddClientLocked(host);
+        rx_last_ = c;
+    }
+    if (c) c->last_seen.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+    return c;
+}
+
+// Resolve host:out_port and open a UDP socket of its family for the new client, evicting the
+// least recently seen client when the table is full. Returns nullptr if the host is unusable.
+OscServer::Client* OscServer::AddClientLocked(const char* host) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    hints.ai_flags = AI_NUMERICHOST;  // liblo reports the sender as a numeric address
+    addrinfo* res = nullptr;
+    std::string port = std::to_string(out_port_);
+    if (getaddrinfo(host, port.c_str(), &hints, &res) != 0 || !res) {
+        std::cerr << "[OSC] cannot resolve client " << host << std::endl;
+        return nullptr;
+    }
+    auto c = std::make_unique<Client>();
+    c->host = host;
+    c->fd = socket(res->ai_family, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (c->fd < 0 || res->ai_addrlen > sizeof(c->addr)) {
+        std::cerr << "[OSC] cannot open feedback socket for " << host << std::endl;
+        freeaddrinfo(res);
+        return nullptr;
+    }
+    std::memcpy(c->addr, res->ai_addr, res->ai_addrlen);
+    c->addr_len = static_cast<unsigned int>(res->ai_addrlen);
+    freeaddrinfo(res);
+
+    if (clients_.size() >= kMaxClients) {
+        size_t oldest = 0;
+        for (size_t i = 1; i < clients_.size(); ++i) {
+            if (clients_[i]->last_seen.load() < clients_[oldest]->last_seen.load()) oldest = i;
+        }
+        std::cout << "[OSC] client table full, dropping " << clients_[oldest]->host << std::endl;
+        clients_.erase(clients_.begin() + oldest);
     }
-    client_changed_.store(false);
+    std::cout << "[OSC] client " << host << " connected, feedback -> port " << out_port_ << std::endl;
+    clients_.push_back(std::move(c));
+    feedback_request_.store(true);
+    return clients_.back().get();
 }
 
 void OscServer::EnqueueCommand(const OscCommand& cmd, const char* client_host) {
+    queue_.push(cmd);  // full ring: dropped and counted
+    Touch(client_host);
+    Wake();
+}
+
+void OscServer::HandleClientCommand(const OscCommand& cmd, const char* client_host) {
+    Client* c = Touch(client_host);
+    if (!c) return;
     {
-        std::lock_guard<std::mutex> lk(queue_mtx_);
-        queue_.push(cmd);
-    }
-    if (client_host && *client_host) {
         std::lock_guard<std::mutex> lk(client_mtx_);
-        if (client_host_ != client_host || !client_) {
-            client_host_ = client_host;
-            if (client_) { lo_address_free((lo_address)client_); client_ = nullptr; }
-            std::string port = std::to_string(out_port_);
-            client_ = (void*)lo_address_new(client_host, port.c_str());
-            client_changed_.store(true);
+        if (cmd.type == OscCmdType::QueryAll) {
+            c->needs_dump = true;
+        } else if (cmd.type == OscCmdType::Subscribe && cmd.index >= 0 && cmd.index < 32) {
+            uint32_t bit = 1u << cmd.index;
+            if (cmd.value > 0.5f) {
+                if (!(c->families & bit)) c->needs_dump = true;  // newly subscribed family starts full
+                c->families |= bit;
+            } else {
+                c->families &= ~bit;
+            }
+        } else if (cmd.type == OscCmdType::MeterRate) {
+            float hz = cmd.value;
+            c->meter_hz = hz <= 0.0f ? 0 : std::min(kMaxMeterHz, std::max(1, static_cast<int>(hz + 0.5f)));
+            c->meter_next = Clock::time_point{};
         }
     }
+    feedback_request_.store(true);
+    Wake();
+}
+
+size_t OscServer::DrainCommands(std::vector<OscCommand>& out) {
+    out.clear();
+    if (out.capacity() < kQueueCapacity) out.reserve(kQueueCapacity);  // once per vector
+    // Reset and re-arm the wakeup before popping: a push that lands after the last pop below
+    // signals again, so nothing is left queued without the fd readable. The read is
+    // unconditional because a producer may have disarmed but not yet written.
+    if (wake_fd_ >= 0) {
+        uint64_t count;
+        (void)!read(wake_fd_, &count, sizeof(count));
+        wake_armed_.store(true, std::memory_order_release);
+    }
+    OscCommand cmd;
+    while (queue_.pop(cmd)) out.push_back(cmd);
+    return out.size();
+}
+
+size_t OscServer::ClientCount() const {
+    std::lock_guard<std::mutex> lk(client_mtx_);
+    return clients_.size();
 }
 
-std::vector<OscCommand> OscServer::DrainCommands() {
-    std::vector<OscCommand> out;
-    std::lock_guard<std::mutex> lk(queue_mtx_);
-    while (!queue_.empty()) {
-        out.push_back(queue_.front());
-        queue_.pop();
+std::vector<OscServer::ClientInfo> OscServer::Clients() const {
+    std::vector<ClientInfo> out;
+    int64_t now = Clock::now().time_since_epoch().count();
+    std::lock_guard<std::mutex> lk(client_mtx_);
+    for (const auto& c : clients_) {
+        ClientInfo info;
+        info.host = c->host;
+        info.port = out_port_;
+        info.idle_seconds = std::chrono::duration<double>(Clock::duration(now - c->last_seen.load())).count();
+        info.families = c->families;
+        info.meter_hz = c->meter_hz;
+        out.push_back(info);
     }
     return out;
 }
 
-bool OscServer::HasClient() const {
+bool OscServer::AnySubscribed(uint32_t families) const {
+    std::lock_guard<std::mutex> lk(client_mtx_);
+    for (const auto& c : clients_) {
+        if (c->families & families) return true;
+    }
+    return false;
+}
+
+bool OscServer::WantsMeters() const {
+    std::lock_guard<std::mutex> lk(client_mtx_);
+    for (const auto& c : clients_) {
+        if (c->meter_hz > 0) return true;
+    }
+    return false;
+}
+
+// "/meters" ",b" <int32 size> <data, zero-padded to 4 bytes>
+void OscServer::SendMeters(const uint8_t* data, size_t len) {
+    static const char kHeader[12] = {'/', 'm', 'e', 't', 'e', 'r', 's', 0, ',', 'b', 0, 0};
+    size_t total = sizeof(kHeader) + 4 + ((len + 3) & ~size_t(3));
+    bool encoded = false;
+
+    auto now = Clock::now();
     std::lock_guard<std::mutex> lk(client_mtx_);
-    return client_ != nullptr;
+    for (auto& c : clients_) {
+        if (c->meter_hz <= 0 || now < c->meter_next) continue;
+        // Keep the cadence; a client that fell more than a period behind restarts from now.
+        auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)) / c->meter_hz;
+        c->meter_next = (now - c->meter_next < period) ? c->meter_next + period : now + period;
+        if (!encoded) {
+            meter_packet_.assign(total, 0);
+            std::memcpy(meter_packet_.data(), kHeader, sizeof(kHeader));
+            uint32_t size_be = htonl(static_cast<uint32_t>(len));
+            std::memcpy(meter_packet_.data() + sizeof(kHeader), &size_be, 4);
+            std::memcpy(meter_packet_.data() + sizeof(kHeader) + 4, data, len);
+            encoded = true;
+        }
+        SendPacketLocked(*c, meter_packet_.data(), total);
+    }
+}
+
+// ── Feedback ──
+
+void OscServer::SendPacketLocked(const Client& c, const char* data, size_t len) {
+    if (c.fd < 0 || len == 0) return;
+    sendto(c.fd, data, len, MSG_DONTWAIT, reinterpret_cast<const sockaddr*>(c.addr), c.addr_len);
+}
+
+void OscServer::SendFloat(const OscFloatMessage& msg, float value) {
+    if (batching_) {
+        feedback_.emplace_back(&msg, value);
+        return;
+    }
+    BeginFeedback();
+    feedback_.emplace_back(&msg, value);
+    EndFeedback();
 }
 
-bool OscServer::TakeClientChanged() {
-    return client_changed_.exchange(false);
+void OscServer::BeginFeedback() {
+    batching_ = true;
+    feedback_.clear();
 }
 
-void OscServer::SendFloat(const std::string& path, float value) {
+void OscServer::EndFeedback() {
+    batching_ = false;
+    if (feedback_.empty()) return;
     std::lock_guard<std::mutex> lk(client_mtx_);
-    if (!client_) return;
-    lo_send((lo_address)client_, path.c_str(), "f", value);
+    for (auto& c : clients_) SendToClientLocked(*c);
+}
+
+// Diff the collected values against what this client was last sent and send it the changes in
+// its subscribed families: bundles of at most kMaxBundleBytes, or a plain message if there is
+// only one.
+void OscServer::SendToClientLocked(Client& c) {
+    // "#bundle\0" + time tag (1 = immediately), then each element is a 4-byte big-endian size
+    // followed by the message.
+    static const char kBundleHeader[16] = {'#', 'b', 'u', 'n', 'd', 'l', 'e', 0, 0, 0, 0, 0, 0, 0, 0, 1};
+    if (packet_.size() < kMaxBundleBytes) packet_.resize(kMaxBundleBytes);
+
+    size_t len = 0;
+    int in_packet = 0;
+    auto flush = [&]() {
+        if (in_packet == 1) {
+            // Lone message: skip the bundle header and the element size.
+            SendPacketLocked(c, packet_.data() + sizeof(kBundleHeader) + 4, len - sizeof(kBundleHeader) - 4);
+        } else if (in_packet > 1) {
+            SendPacketLocked(c, packet_.data(), len);
+        }
+        len = 0;
+        in_packet = 0;
+    };
+
+    for (const auto& fb : feedback_) {
+        const OscFloatMessage& msg = *fb.first;
+        if (!(c.families & msg.family())) continue;
+        if (msg.slot() >= c.last_sent.size()) c.last_sent.resize(msg.slot() + 1, NAN);
+        float& last = c.last_sent[msg.slot()];
+        if (!c.needs_dump && last == fb.second) continue;
+        last = fb.second;
+
+        size_t elem = 4 + msg.size();
+        if (len > 0 && len + elem > kMaxBundleBytes) flush();
+        if (len == 0) {
+            std::memcpy(packet_.data(), kBundleHeader, sizeof(kBundleHeader));
+            len = sizeof(kBundleHeader);
+        }
+        if (len + elem > packet_.size()) packet_.resize(len + elem);  // oversized lone address
+        uint32_t size_be = htonl(static_cast<uint32_t>(msg.size()));
+        std::memcpy(packet_.data() + len, &size_be, 4);
+        msg.Encode(fb.second, packet_.data() + len + 4);
+        len += elem;
+        in_packet++;
+    }
+    flush();
+    c.needs_dump = false;
 }
 
 } // namespace TotalMixer
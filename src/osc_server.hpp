@@ -2,9 +2,12 @@
 
 #include <string>
 #include <vector>
-#include <queue>
+#include <memory>
 #include <mutex>
 #include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "mpsc_queue.hpp"
 
 namespace TotalMixer {
 
@@ -14,20 +17,70 @@ enum class OscCmdType {
     InFader,  InMute,
     PbFader,  PbMute,
     SubmixSelect,
-    QueryAll,
+    MixInFader, MixInMute,  // any crosspoint: index = source, output = submix
+    MixPbFader, MixPbMute,
+    QueryAll,   // handled by OscServer for the sending client, never queued
+    Subscribe,  // ditto; index = OscFamily bit number, value = 1 subscribe / 0 unsubscribe
+    MeterRate,  // ditto; value = meter blobs per second (0 = off)
     Unknown
 };
 
 struct OscCommand {
     OscCmdType type = OscCmdType::Unknown;
     int index = 0;       // 0-based channel (already converted from the 1-based OSC path)
+    int output = 0;      // 0-based submix, for the /mix/* crosspoint addresses only
     float value = 0.0f;  // normalized 0..1 for faders; 0/1 for toggles; ignored otherwise
 };
 
+// Feedback address families, as bit flags. Each client receives the families it is subscribed
+// to (/subscribe/<family> 1|0); new clients start with kOscDefaultFamilies. The full matrix is
+// opt-in: its first dump alone is 1296 values.
+enum OscFamily : uint32_t {
+    OscFamilyOut    = 1u << 0,  // /out/*
+    OscFamilyIn     = 1u << 1,  // /in/*
+    OscFamilyPb     = 1u << 2,  // /pb/*
+    OscFamilySubmix = 1u << 3,  // /submix/current
+    OscFamilyMix    = 1u << 4,  // /mix/* (every crosspoint of both matrices)
+};
+constexpr uint32_t kOscDefaultFamilies = OscFamilyOut | OscFamilyIn | OscFamilyPb | OscFamilySubmix;
+
+// One outbound OSC message with a single float argument, encoded once: the padded address and
+// ",f" type tag never change, so sending it only patches the 4-byte argument. Feedback senders
+// build one per address up front instead of formatting paths on every push. family says which
+// subscription it belongs to; slot is a small index unique across the sender's messages, under
+// which each client remembers the value it was last sent.
+class OscFloatMessage {
+public:
+    OscFloatMessage() = default;
+    OscFloatMessage(const std::string& path, uint32_t family, uint32_t slot);
+
+    const std::string& path() const { return path_; }
+    uint32_t family() const { return family_; }
+    uint32_t slot() const { return slot_; }
+    size_t size() const { return encoded_.size(); }
+    // Write the message carrying value to out, which must have room for size() bytes.
+    void Encode(float value, char* out) const;
+
+private:
+    std::string path_;
+    uint32_t family_ = 0;
+    uint32_t slot_ = 0;
+    std::vector<char> encoded_;  // padded path + padded type tag + argument slot
+};
+
 // UDP OSC endpoint. A liblo server thread parses inbound messages into OscCommands that the
-// GUI thread drains and applies; the GUI thread sends feedback back to the discovered client.
-// All mixer state lives on the GUI thread, so only the command queue and the client address are
-// shared across threads. The liblo handles are kept as void* so <lo/lo.h> stays out of this header.
+// GUI thread drains and applies; the GUI thread sends feedback back to the discovered clients.
+// All mixer state lives on the GUI thread, so only the command queue and the client table are
+// shared across threads. The command queue is a bounded lock-free ring, so the receive thread
+// never waits on the thread draining it; the client lock is only taken when a message comes from
+// a different client than the one before, or changes its subscriptions.
+//
+// Every host that sends a recognized message becomes a client (up to kMaxClients; the one heard
+// from least recently makes room). Each client has its own subscriptions and remembers what it
+// was last sent, so it gets its own diff stream: a newcomer or a client that sends /query gets
+// a full dump, everyone else only changes. Feedback is written straight to UDP sockets from
+// preencoded OscFloatMessages. The liblo handle and socket addresses are kept opaque so
+// <lo/lo.h> and the socket headers stay out of this header.
 class OscServer {
 public:
     OscServer();
@@ -37,39 +90,118 @@ public:
     OscServer& operator=(const OscServer&) = delete;
 
     // Bind the incoming UDP port and start the receive thread. out_port is where feedback is sent
-    // (to whatever host first contacts us). Returns false if the port could not be bound.
+    // (on each client's host). Returns false if the port could not be bound.
     bool Start(int in_port, int out_port);
     void Stop();
     bool IsRunning() const { return running_.load(); }
 
-    // Move all queued inbound commands out (GUI thread).
-    std::vector<OscCommand> DrainCommands();
-
-    // True if at least one client has been discovered.
-    bool HasClient() const;
-    // Returns true once after the client address changes (e.g. a new controller connected),
-    // so the caller can trigger a full state resync. Resets the flag.
-    bool TakeClientChanged();
-
-    // Send a single float feedback message to the current client (GUI thread). No-op if none.
-    void SendFloat(const std::string& path, float value);
+    // Capacity of the inbound command ring. Commands arriving while it is full are dropped.
+    static constexpr size_t kQueueCapacity = 1024;
+
+    // Move all queued inbound commands into out, replacing its contents (GUI thread). Reuses
+    // out's capacity, so a caller that keeps the vector never allocates. Returns the count.
+    size_t DrainCommands(std::vector<OscCommand>& out);
+    // Commands dropped because the queue was full, since construction.
+    uint64_t DroppedCommands() const { return queue_.dropped(); }
+
+    // An eventfd that polls readable once there is something for the draining thread to do: a
+    // queued command, or a client that needs feedback (TakeFeedbackRequest). It is signalled
+    // only on the transition from idle, not per message, and DrainCommands() resets it. Valid
+    // for the lifetime of the server, across Start()/Stop().
+    int WakeupFd() const { return wake_fd_; }
+    // True (once) if a client registered, sent /query or changed its subscriptions since the
+    // last call, so the owner pushes feedback without waiting for a state change.
+    bool TakeFeedbackRequest() { return feedback_request_.exchange(false); }
+
+    // ── Clients ──
+    static constexpr size_t kMaxClients = 8;
+    struct ClientInfo {
+        std::string host;
+        int port = 0;               // feedback port on that host
+        double idle_seconds = 0.0;  // since the client last sent anything
+        uint32_t families = 0;      // OscFamily bits
+        int meter_hz = 0;           // meter blobs per second, 0 = none
+    };
+    bool HasClient() const { return ClientCount() > 0; }
+    size_t ClientCount() const;
+    std::vector<ClientInfo> Clients() const;
+    // True if any client is subscribed to one of the given families; lets the sender skip
+    // building values nobody receives.
+    bool AnySubscribed(uint32_t families) const;
+
+    // Send a single float feedback message to every subscribed client (GUI thread).
+    // Between BeginFeedback() and EndFeedback() the value is only collected; msg must then stay
+    // alive until EndFeedback().
+    void SendFloat(const OscFloatMessage& msg, float value);
+
+    // ── Meters ──
+    // Clients ask for level meters with /meters/rate <hz> and then receive "/meters" messages
+    // carrying one blob with every channel, at most kMaxMeterHz times a second.
+    static constexpr int kMaxMeterHz = 30;
+    // True if any client wants meters; lets the sender skip metering altogether.
+    bool WantsMeters() const;
+    // Send the blob to every client whose meter period has elapsed (GUI thread).
+    void SendMeters(const uint8_t* data, size_t len);
+
+    // Feedback batching (GUI thread). Submit the current value of every address between
+    // BeginFeedback() and EndFeedback(); EndFeedback() diffs them against what each client was
+    // last sent and sends each client its changes as OSC bundles of at most kMaxBundleBytes. A
+    // client with a single change gets a plain message. Once the buffers have grown to a push's
+    // size, nothing here allocates.
+    static constexpr size_t kMaxBundleBytes = 1400;  // 1500-byte Ethernet MTU minus IP/UDP headers, with margin
+    void BeginFeedback();
+    void EndFeedback();
 
     // Called by the (file-local) liblo handler; pushes a parsed command and registers the client.
     void EnqueueCommand(const OscCommand& cmd, const char* client_host);
+    // Called by the liblo handler for /query, /subscribe/* and /meters/rate, which only concern
+    // the sender.
+    void HandleClientCommand(const OscCommand& cmd, const char* client_host);
 
 private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Client {
+        std::string host;
+        int fd = -1;                         // UDP socket for the address family
+        alignas(8) unsigned char addr[128];  // struct sockaddr_storage
+        unsigned int addr_len = 0;
+        std::atomic<int64_t> last_seen{0};   // Clock ticks; stored by the receive thread
+        uint32_t families = kOscDefaultFamilies;
+        bool needs_dump = true;
+        std::vector<float> last_sent;        // by message slot; NaN = not sent yet
+        int meter_hz = 0;
+        Clock::time_point meter_next;        // earliest time for the next meter blob
+        ~Client();
+    };
+
     void* server_ = nullptr;  // lo_server_thread
-    void* client_ = nullptr;  // lo_address
     int out_port_ = 9001;
 
-    mutable std::mutex queue_mtx_;
-    std::queue<OscCommand> queue_;
+    MpscQueue<OscCommand, kQueueCapacity> queue_;
+    int wake_fd_ = -1;
+    std::atomic<bool> wake_armed_{true};  // next producer signals wake_fd_
+    std::atomic<bool> feedback_request_{false};
 
+    // Client table. Entries are added and evicted only by the receive thread (and cleared by
+    // Stop() once it is gone), so it may keep rx_last_ without holding the lock.
     mutable std::mutex client_mtx_;
-    std::string client_host_;
-    std::atomic<bool> client_changed_{false};
+    std::vector<std::unique_ptr<Client>> clients_;
+    Client* rx_last_ = nullptr;
 
     std::atomic<bool> running_{false};
+
+    // Collected feedback and the datagram it is encoded into; both keep their capacity.
+    bool batching_ = false;
+    std::vector<std::pair<const OscFloatMessage*, float>> feedback_;
+    std::vector<char> packet_;
+    std::vector<char> meter_packet_;
+
+    void Wake();
+    Client* Touch(const char* host);
+    Client* AddClientLocked(const char* host);
+    void SendToClientLocked(Client& c);
+    void SendPacketLocked(const Client& c, const char* data, size_t len);
 };
 
 } // namespace TotalMixer
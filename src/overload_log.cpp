@@ -0,0 +1,270 @@
+#include "overload_log.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <iostream>
+#include <new>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "config_manager.hpp"
+#include "db_tables.hpp"
+
+namespace TotalMixer {
+
+// File layout: this header, then capacity OverloadEvent records. count and cleared are shared
+// with other processes through the mapping, hence lock-free atomics.
+struct OverloadLog::Header {
+    char magic[8];                  // "TMOVRLOG"
+    uint32_t version;
+    uint32_t capacity;
+    std::atomic<uint64_t> count;    // events ever appended; the newest is at (count - 1) % capacity
+    std::atomic<uint64_t> cleared;  // count at the last Clear(); events before it are hidden
+    uint8_t reserved[32];
+};
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "log counters are shared between processes");
+
+static constexpr char kMagic[8] = {'T', 'M', 'O', 'V', 'R', 'L', 'O', 'G'};
+static constexpr uint32_t kVersion = 1;
+
+OverloadLog::~OverloadLog() {
+    Close();
+}
+
+std::string OverloadLog::DefaultPath() {
+    return (std::filesystem::path(ConfigManager::GetConfigPath()).parent_path() / "overloads.log").string();
+}
+
+bool OverloadLog::OpenForWriting(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return MapLocked(path, true, true);
+}
+
+bool OverloadLog::Open(const std::string& path, bool writable) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return MapLocked(path, writable, false);
+}
+
+// Called with mtx_ held. create = record into the file: take the writer lock and (re)initialize
+// anything that is not a log of this format.
+bool OverloadLog::MapLocked(const std::string& path, bool writable, bool create) {
+    static_assert(sizeof(Header) == 64, "log header is 64 bytes on disk");
+    if (map_) {
+        munmap(map_, map_bytes_);
+        map_ = nullptr;
+    }
+    if (fd_ >= 0) close(fd_);
+    fd_ = -1;
+    header_ = nullptr;
+    events_ = nullptr;
+    writable_ = recording_ = false;
+    lit_.fill(Lit{});
+    path_ = path;
+
+    if (create) {
+        std::error_code ec;
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+    }
+    int fd = open(path.c_str(), (writable ? O_RDWR : O_RDONLY) | O_CLOEXEC | (create ? O_CREAT : 0), 0644);
+    if (fd < 0) {
+        std::cerr << "[OVR] cannot open " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    if (create && flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        std::cerr << "[OVR] " << path << " is being recorded by another process; not recording" << std::endl;
+        close(fd);
+        return false;
+    }
+
+    const size_t want = sizeof(Header) + sizeof(OverloadEvent) * static_cast<size_t>(kCapacity);
+    struct stat st{};
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+    size_t bytes = static_cast<size_t>(st.st_size);
+    bool fresh = false;
+    if (create && bytes != want) {
+        if (ftruncate(fd, 0) != 0 || ftruncate(fd, static_cast<off_t>(want)) != 0) {
+            std::cerr << "[OVR] cannot size " << path << ": " << std::strerror(errno) << std::endl;
+            close(fd);
+            return false;
+        }
+        bytes = want;
+        fresh = true;
+    }
+    if (bytes < sizeof(Header)) {
+        std::cerr << "[OVR] " << path << " is not an overload log" << std::endl;
+        close(fd);
+        return false;
+    }
+
+    void* map = mmap(nullptr, bytes, PROT_READ | (writable ? PROT_WRITE : 0), MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        std::cerr << "[OVR] cannot map " << path << ": " << std::strerror(errno) << std::endl;
+        close(fd);
+        return false;
+    }
+    Header* header = static_cast<Header*>(map);
+    bool valid = std::memcmp(header->magic, kMagic, sizeof(kMagic)) == 0 && header->version == kVersion &&
+                 header->capacity > 0 && bytes == sizeof(Header) + sizeof(OverloadEvent) * header->capacity;
+    if (create && (fresh || !valid || header->capacity != kCapacity)) {
+        std::memset(map, 0, bytes);
+        header = new (map) Header{};
+        std::memcpy(header->magic, kMagic, sizeof(kMagic));
+        header->version = kVersion;
+        header->capacity = kCapacity;
+        header->count.store(0, std::memory_order_relaxed);
+        header->cleared.store(0, std::memory_order_relaxed);
+        msync(map, sizeof(Header), MS_ASYNC);
+    } else if (!valid) {
+        std::cerr << "[OVR] " << path << " is not an overload log" << std::endl;
+        munmap(map, bytes);
+        close(fd);
+        return false;
+    }
+
+    fd_ = fd;  // kept open: it holds the writer lock
+    map_ = map;
+    map_bytes_ = bytes;
+    header_ = header;
+    events_ = reinterpret_cast<OverloadEvent*>(static_cast<char*>(map) + sizeof(Header));
+    writable_ = writable;
+    recording_ = create;
+    return true;
+}
+
+void OverloadLog::Close() {
+    EndAll();
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (map_) munmap(map_, map_bytes_);
+    if (fd_ >= 0) close(fd_);
+    map_ = nullptr;
+    map_bytes_ = 0;
+    fd_ = -1;
+    header_ = nullptr;
+    events_ = nullptr;
+    writable_ = recording_ = false;
+}
+
+bool OverloadLog::is_open() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return header_ != nullptr;
+}
+
+bool OverloadLog::recording() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return recording_;
+}
+
+std::string OverloadLog::path() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return path_;
+}
+
+// Instantaneous display level → dBFS in hundredths (0 at full scale, -9000 at the meter floor).
+static inline int16_t ToCentiDb(float display) {
+    float cdb = (std::clamp(display, 0.0f, 1.0f) - 1.0f) * kMeterFloorDb * 100.0f;
+    return static_cast<int16_t>(std::lround(cdb));
+}
+
+void OverloadLog::Track(Clock::time_point time, const std::array<MeterLevel, kChannels>& levels) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (!recording_) return;
+    for (int ch = 0; ch < kChannels; ++ch) {
+        Lit& lit = lit_[ch];
+        if (levels[ch].is_overload) {
+            int16_t cdb = ToCentiDb(levels[ch].normalized);
+            if (!lit.on) {
+                lit.on = true;
+                lit.start = time;
+                lit.start_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+                lit.peak_cdb = cdb;
+            } else if (cdb > lit.peak_cdb) {
+                lit.peak_cdb = cdb;
+            }
+        } else if (lit.on) {
+            AppendLocked(ch, lit, time);
+            lit.on = false;
+        }
+    }
+    last_time_ = time;
+}
+
+void OverloadLog::EndAll() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    for (int ch = 0; ch < kChannels; ++ch) {
+        Lit& lit = lit_[ch];
+        if (!lit.on) continue;
+        if (recording_) AppendLocked(ch, lit, last_time_);
+        lit.on = false;
+    }
+}
+
+// The record is complete before count moves past it, so a reader that sees the new count (even
+// in another process) sees the whole event.
+void OverloadLog::AppendLocked(int ch, const Lit& lit, Clock::time_point end) {
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - lit.start).count();
+    OverloadEvent ev;
+    ev.start_ns = lit.start_ns;
+    ev.duration_ms = static_cast<uint32_t>(std::clamp<int64_t>(ms, 0, UINT32_MAX));
+    ev.channel = static_cast<uint8_t>(ch);
+    ev.peak_cdb = lit.peak_cdb;
+    uint64_t n = header_->count.load(std::memory_order_relaxed);
+    events_[n % header_->capacity] = ev;
+    header_->count.store(n + 1, std::memory_order_release);
+}
+
+// The writer may be another process, so the ring can move while it is copied: count is read
+// again afterwards and any copied slot the writer may since have reused is dropped.
+void OverloadLog::Read(std::vector<OverloadEvent>& out, size_t max) const {
+    out.clear();
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (!header_ || max == 0) return;
+    const uint64_t capacity = header_->capacity;
+    uint64_t end = header_->count.load(std::memory_order_acquire);
+    uint64_t begin = std::max(header_->cleared.load(std::memory_order_relaxed), end > capacity ? end - capacity : 0);
+    if (end - begin > max) begin = end - max;
+    if (begin >= end) return;
+
+    out.resize(static_cast<size_t>(end - begin));
+    for (uint64_t i = begin; i < end; ++i) out[static_cast<size_t>(i - begin)] = events_[i % capacity];
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    uint64_t after = header_->count.load(std::memory_order_relaxed);
+    uint64_t safe = after + 1 > capacity ? after + 1 - capacity : 0;  // slot `after` may be mid-write
+    if (safe > begin) out.erase(out.begin(), out.begin() + static_cast<ptrdiff_t>(std::min(safe, end) - begin));
+}
+
+uint64_t OverloadLog::revision() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (!header_) return 0;
+    return header_->count.load(std::memory_order_acquire) + header_->cleared.load(std::memory_order_relaxed);
+}
+
+void OverloadLog::Clear() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (!header_ || !writable_) return;
+    header_->cleared.store(header_->count.load(std::memory_order_acquire), std::memory_order_relaxed);
+}
+
+void OverloadLog::FormatStart(const OverloadEvent& ev, char* buf, size_t size) {
+    if (size == 0) return;
+    time_t secs = static_cast<time_t>(ev.start_ns / 1000000000);
+    int ms = static_cast<int>((ev.start_ns % 1000000000) / 1000000);
+    struct tm tm{};
+    localtime_r(&secs, &tm);
+    char date[32];
+    std::strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", &tm);
+    std::snprintf(buf, size, "%s.%03d", date, ms);
+}
+
+} // namespace TotalMixer
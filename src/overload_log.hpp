@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "meter_bank.hpp"
+
+namespace TotalMixer {
+
+// One overload: a channel's OVR indicator lit at start_ns and went out duration_ms later. This is
+// the on-disk record (16 bytes, host byte order).
+struct OverloadEvent {
+    int64_t start_ns = 0;      // wall clock, ns since the Unix epoch
+    uint32_t duration_ms = 0;
+    uint8_t channel = 0;       // MeterBank channel
+    uint8_t reserved = 0;
+    int16_t peak_cdb = 0;      // highest instantaneous level while lit, in 0.01 dBFS
+};
+static_assert(sizeof(OverloadEvent) == 16, "OverloadEvent is the on-disk record");
+
+// Persistent overload log: a fixed-size ring of OverloadEvent records in a memory-mapped file
+// (overloads.log next to preferences.json), so which channel clipped when survives the OVR
+// indicator going out, the frontend closing and a restart. The newest kCapacity events are kept.
+//
+// The sampler thread feeds Track() every frame; it follows each channel's OVR flag and appends
+// an event when one goes out. Appending is a store into the mapping: no allocation, no syscall.
+// One process records into a file at a time (OpenForWriting() takes an flock); any number may
+// Open() it to read or clear while it records, e.g. `totalmixer overloads`.
+//
+// Track()/EndAll() belong to the sampler thread; everything else may be called from any thread.
+class OverloadLog {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr int kChannels = MeterBank::kChannels;
+    static constexpr uint32_t kCapacity = 65536;
+
+    OverloadLog() = default;
+    ~OverloadLog();
+
+    OverloadLog(const OverloadLog&) = delete;
+    OverloadLog& operator=(const OverloadLog&) = delete;
+
+    // ~/.config/totalmix/overloads.log (follows XDG_CONFIG_HOME like preferences.json).
+    static std::string DefaultPath();
+
+    // Map the log for recording, creating it (or replacing a file that is not a log of this
+    // format). Events already in a valid log are kept. False if another process is recording
+    // into it or it cannot be mapped. Not meant for the sampling path.
+    bool OpenForWriting(const std::string& path);
+    // Map an existing log to read it (writable = true also allows Clear()).
+    bool Open(const std::string& path, bool writable);
+    void Close();
+    bool is_open() const;
+    bool recording() const;
+    std::string path() const;
+
+    // Follow one sampled frame. Never allocates; a no-op unless recording().
+    void Track(Clock::time_point time, const std::array<MeterLevel, kChannels>& levels);
+    // End every overload still lit, as of the last tracked frame (sampling paused or stopped).
+    void EndAll();
+
+    // The newest `max` events still in the log, oldest first (out is replaced).
+    void Read(std::vector<OverloadEvent>& out, size_t max = kCapacity) const;
+    // Changes whenever an event is appended or the log is cleared.
+    uint64_t revision() const;
+    // Hide every event recorded so far (safe while another process records).
+    void Clear();
+
+    // "2026-10-16 21:04:12.345" in local time.
+    static void FormatStart(const OverloadEvent& ev, char* buf, size_t size);
+
+private:
+    struct Header;
+    struct Lit {
+        bool on = false;
+        Clock::time_point start;
+        int64_t start_ns = 0;
+        int16_t peak_cdb = 0;
+    };
+
+    bool MapLocked(const std::string& path, bool writable, bool create);
+    void AppendLocked(int ch, const Lit& lit, Clock::time_point end);
+
+    mutable std::mutex mtx_;
+    std::string path_;
+    int fd_ = -1;
+    void* map_ = nullptr;
+    size_t map_bytes_ = 0;
+    Header* header_ = nullptr;
+    OverloadEvent* events_ = nullptr;
+    bool writable_ = false;
+    bool recording_ = false;
+    std::array<Lit, kChannels> lit_{};
+    Clock::time_point last_time_;
+};
+
+} // namespace TotalMixer
@@ -0,0 +1,152 @@
+// `totalmixer overloads` subcommand: list (or clear) the overloads recorded in the persistent
+// overload log.
+//
+// Reads the memory-mapped log directly (no engine, no ALSA), so it works while the daemon or the
+// GUI is recording into it, and on a machine without the card.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <strings.h>
+#include <vector>
+
+#include "cli_subcommands.hpp"
+#include "meter_bank.hpp"
+#include "overload_log.hpp"
+
+namespace {
+
+void PrintUsage() {
+    std::cout <<
+        "Usage: totalmixer overloads [--channel <name>] [--since <minutes>] [--last <n>]\n"
+        "                            [--clear] [--file <path>]\n"
+        "\n"
+        "List the overloads (OVR) recorded while metering, oldest first: when each started,\n"
+        "which channel, how long the indicator stayed lit and the highest level reached.\n"
+        "\n"
+        "Options:\n"
+        "  --channel <name>   Only this channel, e.g. \"In 3\", \"Out Line 1\", \"PB 7\"\n"
+        "  --since <minutes>  Only overloads that started in the last <minutes> minutes\n"
+        "  --last <n>         Only the newest <n> matching overloads\n"
+        "  --clear            Clear the log and exit\n"
+        "  --file <path>      Log file (default: " << TotalMixer::OverloadLog::DefaultPath() << ")\n"
+        "  -h, --help         Show this help and exit\n";
+}
+
+bool ParseCount(const char* flag, const char* val, long& out) {
+    char* end = nullptr;
+    long parsed = std::strtol(val, &end, 10);
+    if (end == val || *end != '\0' || parsed <= 0) {
+        std::cerr << "Error: " << flag << " expects a positive integer, got '" << val << "'\n";
+        return false;
+    }
+    out = parsed;
+    return true;
+}
+
+} // namespace
+
+namespace TotalMixer {
+
+// argv[0] is "overloads"; options follow from index 1.
+int RunOverloads(int argc, char** argv) {
+    int channel = -1;  // -1 = every channel
+    long since_min = 0;
+    long last = 0;
+    bool clear = false;
+    std::string path = OverloadLog::DefaultPath();
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        auto value = [&](const char* flag) -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: " << flag << " requires a value\n";
+                return nullptr;
+            }
+            return argv[++i];
+        };
+        if (std::strcmp(arg, "-h") == 0 || std::strcmp(arg, "--help") == 0) {
+            PrintUsage();
+            return 0;
+        } else if (std::strcmp(arg, "--channel") == 0) {
+            const char* val = value(arg);
+            if (!val) return 2;
+            for (int ch = 0; ch < MeterBank::kChannels && channel < 0; ++ch) {
+                if (strcasecmp(val, MeterBank::ChannelName(ch)) == 0) channel = ch;
+            }
+            if (channel < 0) {
+                std::cerr << "Error: unknown channel '" << val << "'\n";
+                return 2;
+            }
+        } else if (std::strcmp(arg, "--since") == 0) {
+            const char* val = value(arg);
+            if (!val || !ParseCount(arg, val, since_min)) return 2;
+        } else if (std::strcmp(arg, "--last") == 0) {
+            const char* val = value(arg);
+            if (!val || !ParseCount(arg, val, last)) return 2;
+        } else if (std::strcmp(arg, "--clear") == 0) {
+            clear = true;
+        } else if (std::strcmp(arg, "--file") == 0) {
+            const char* val = value(arg);
+            if (!val) return 2;
+            path = val;
+        } else {
+            std::cerr << "Error: unknown argument '" << arg << "'\n";
+            PrintUsage();
+            return 2;
+        }
+    }
+
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec)) {
+        std::cout << "No overloads recorded (" << path << " does not exist yet).\n";
+        return 0;
+    }
+
+    OverloadLog log;
+    if (!log.Open(path, clear)) return 1;
+    if (clear) {
+        log.Clear();
+        std::cout << "Cleared " << path << "\n";
+        return 0;
+    }
+
+    std::vector<OverloadEvent> events;
+    log.Read(events);
+
+    int64_t since_ns = 0;
+    if (since_min > 0) {
+        auto now = std::chrono::system_clock::now().time_since_epoch();
+        since_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - std::chrono::minutes(since_min)).count();
+    }
+    std::vector<const OverloadEvent*> shown;
+    for (const OverloadEvent& ev : events) {
+        if (channel >= 0 && ev.channel != channel) continue;
+        if (ev.start_ns < since_ns) continue;
+        shown.push_back(&ev);
+    }
+    if (last > 0 && shown.size() > static_cast<size_t>(last)) {
+        shown.erase(shown.begin(), shown.end() - last);
+    }
+
+    if (shown.empty()) {
+        std::cout << "No overloads recorded.\n";
+        return 0;
+    }
+    std::printf("%-23s  %-13s  %10s  %10s\n", "Start", "Channel", "Duration", "Peak");
+    for (const OverloadEvent* ev : shown) {
+        char start[40];
+        OverloadLog::FormatStart(*ev, start, sizeof(start));
+        const char* name = MeterBank::ChannelName(ev->channel);
+        std::printf("%-23s  %-13s  %8.2f s  %5.1f dBFS\n", start, name ? name : "?",
+                    ev->duration_ms / 1000.0, ev->peak_cdb / 100.0);
+    }
+    std::printf("%zu overload%s\n", shown.size(), shown.size() == 1 ? "" : "s");
+    return 0;
+}
+
+} // namespace TotalMixer
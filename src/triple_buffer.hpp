@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+namespace TotalMixer {
+
+// Single-producer / single-consumer triple buffer. The writer fills back() and publish()es it;
+// the reader's front() returns the most recently published value. Neither side ever blocks or
+// waits for the other: the three slots are only ever swapped through one atomic index, so the
+// reader can hold a published value for a whole frame while the writer keeps publishing.
+//
+// back() is not cleared between publishes (it holds the value from two publishes ago), so the
+// writer must overwrite whatever it needs to be current.
+template <typename T>
+class TripleBuffer {
+public:
+    // Writer side.
+    T& back() { return slots[back_idx]; }
+    void publish() {
+        back_idx = middle.exchange(back_idx | kFresh, std::memory_order_acq_rel) & kIndexMask;
+    }
+
+    // Reader side. Picks up the latest publish, if there was one since the last call.
+    const T& front() {
+        if (middle.load(std::memory_order_relaxed) & kFresh) {
+            front_idx = middle.exchange(front_idx, std::memory_order_acq_rel) & kIndexMask;
+        }
+        return slots[front_idx];
+    }
+
+private:
+    static constexpr unsigned int kIndexMask = 0x3;
+    static constexpr unsigned int kFresh = 0x4;  // middle holds a publish the reader has not taken
+
+    std::array<T, 3> slots{};
+    unsigned int back_idx = 0;                   // writer-owned
+    unsigned int front_idx = 1;                  // reader-owned
+    std::atomic<unsigned int> middle{2};         // exchanged by both
+};
+
+} // namespace TotalMixer
@@ -0,0 +1,209 @@
+#include "write_queue.hpp"
+#include <iostream>
+
+namespace TotalMixer {
+
+WriteQueue::WriteQueue() {}
+
+WriteQueue::~WriteQueue() {
+    Stop();
+}
+
+void WriteQueue::Start(AlsaBackend* backend) {
+    std::lock_guard<std::mutex> worker_lock(worker_mtx_);
+    StopLocked();
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        backend_ = backend;
+        stop_ = false;
+        stats_ = Stats{};
+        latency_total_ms_ = 0.0;
+        latency_samples_ = 0;
+        // Row slots belong to the previous connection's numids; the storage is kept.
+        row_by_numid_.assign(row_by_numid_.size(), -1);
+        index_.clear();
+    }
+    StartWorkerLocked();
+}
+
+void WriteQueue::Stop() {
+    std::lock_guard<std::mutex> worker_lock(worker_mtx_);
+    StopLocked();
+}
+
+// With worker_mtx_ held.
+void WriteQueue::StopLocked() {
+    if (worker_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            stop_ = true;
+            cv_.notify_all();
+        }
+        worker_.join();
+    }
+    // Whatever the worker had not picked up yet still belongs to the hardware.
+    Flush();
+    std::lock_guard<std::mutex> lock(mtx_);
+    backend_ = nullptr;
+}
+
+void WriteQueue::SetRate(int hz) {
+    std::lock_guard<std::mutex> worker_lock(worker_mtx_);
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        rate_hz_ = hz < 0 ? 0 : hz;
+        cv_.notify_all();
+    }
+    StartWorkerLocked();
+}
+
+// With worker_mtx_ held. Write-through (rate 0) needs no worker, as Set() flushes inline; a
+// worker already running when the rate drops to 0 just finds nothing left to do.
+void WriteQueue::StartWorkerLocked() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (worker_.joinable() || !backend_ || rate_hz_ == 0) return;
+    stop_ = false;
+    worker_ = std::thread(&WriteQueue::WorkerMain, this);
+}
+
+int WriteQueue::rate() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return rate_hz_;
+}
+
+// ── Queueing ──
+// The table grows only the first time a row (numid) is written on this connection.
+int WriteQueue::KeyLocked(const ControlHandle& row, unsigned int element) {
+    if (element >= kRowElements) return -1;
+    if (row.numid >= row_by_numid_.size()) row_by_numid_.resize(row.numid + 1, -1);
+    int& slot = row_by_numid_[row.numid];
+    if (slot < 0) {
+        slot = static_cast<int>(index_.size() / kRowElements);
+        index_.resize(index_.size() + kRowElements, -1);
+    }
+    return slot * static_cast<int>(kRowElements) + static_cast<int>(element);
+}
+
+void WriteQueue::Add(const ControlHandle& row, unsigned int element, long value, Clock::time_point now) {
+    stats_.queued++;
+    int key = KeyLocked(row, element);
+    int at = key >= 0 ? index_[key] : -1;
+    for (size_t i = 0; key < 0 && at < 0 && i < pending_.size(); ++i) {
+        if (pending_[i].row.numid == row.numid && pending_[i].element == element) at = static_cast<int>(i);
+    }
+    if (at >= 0) {
+        pending_[at].value = value;  // keep the original queue time for the latency stat
+        stats_.coalesced++;
+        return;
+    }
+    if (key >= 0) index_[key] = static_cast<int>(pending_.size());
+    pending_.push_back(Pending{row, element, value, now, key});
+    if (pending_.size() > stats_.max_depth) stats_.max_depth = pending_.size();
+}
+
+void WriteQueue::Set(const ControlHandle& row, unsigned int element, long value) {
+    std::unique_lock<std::mutex> lock(mtx_);
+    if (!backend_ || !row.valid()) return;
+    Add(row, element, value, Clock::now());
+    if (rate_hz_ == 0) FlushLocked(lock);
+    else cv_.notify_all();
+}
+
+void WriteQueue::Set(const MatrixTransaction& txn) {
+    if (txn.empty()) return;
+    std::unique_lock<std::mutex> lock(mtx_);
+    if (!backend_) return;
+    auto now = Clock::now();
+    for (const auto& e : txn.pending()) {
+        if (e.row.valid()) Add(e.row, e.element, e.value, now);
+    }
+    if (rate_hz_ == 0) FlushLocked(lock);
+    else cv_.notify_all();
+}
+
+// ── Flushing ──
+bool WriteQueue::Flush() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    return FlushLocked(lock);
+}
+
+// Called with the lock held; releases it around the ALSA commit. Flushes are serialized, so an
+// older value can never reach the hardware after a newer one for the same element.
+bool WriteQueue::FlushLocked(std::unique_lock<std::mutex>& lock) {
+    cv_.wait(lock, [this] { return !writing_; });
+    if (pending_.empty() || !backend_) return true;
+
+    for (const Pending& p : pending_) {
+        if (p.key >= 0) index_[p.key] = -1;
+    }
+    flushing_.swap(pending_);
+    writing_ = true;
+    AlsaBackend* backend = backend_;
+    lock.unlock();
+
+    for (const Pending& p : flushing_) txn_.set(p.row, p.element, p.value);
+    size_t rows = 0;
+    for (size_t i = 0; i < flushing_.size(); ++i) {
+        bool seen = false;
+        for (size_t j = 0; j < i && !seen; ++j) seen = (flushing_[j].row.numid == flushing_[i].row.numid);
+        if (!seen) rows++;
+    }
+    bool ok = backend->commit(txn_);
+    auto done = Clock::now();
+    if (!ok) std::cerr << "WriteQueue: commit of " << flushing_.size() << " element(s) failed" << std::endl;
+
+    lock.lock();
+    stats_.flushes++;
+    stats_.row_writes += rows;
+    if (!ok) stats_.failed++;
+    for (const Pending& p : flushing_) {
+        double ms = std::chrono::duration<double, std::milli>(done - p.queued).count();
+        latency_total_ms_ += ms;
+        latency_samples_++;
+        if (ms > stats_.max_latency_ms) stats_.max_latency_ms = ms;
+    }
+    flushing_.clear();
+    writing_ = false;
+    cv_.notify_all();
+    return ok;
+}
+
+// Waits for work, then holds off until the next flush slot so everything queued in between is
+// coalesced into the same commit.
+void WriteQueue::WorkerMain() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    Clock::time_point last_flush = Clock::now() - std::chrono::seconds(1);
+    while (!stop_) {
+        cv_.wait(lock, [this] { return stop_ || !pending_.empty(); });
+        if (stop_) break;
+        if (rate_hz_ > 0) {
+            auto next = last_flush + std::chrono::microseconds(1000000 / rate_hz_);
+            if (cv_.wait_until(lock, next, [this] { return stop_; })) break;
+        }
+        last_flush = Clock::now();
+        FlushLocked(lock);
+    }
+}
+
+// ── Status ──
+bool WriteQueue::idle() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return pending_.empty() && !writing_;
+}
+
+WriteQueue::Stats WriteQueue::stats() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    Stats s = stats_;
+    s.depth = pending_.size();
+    s.avg_latency_ms = latency_samples_ > 0 ? latency_total_ms_ / latency_samples_ : 0.0;
+    return s;
+}
+
+void WriteQueue::ResetStats() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    stats_ = Stats{};
+    latency_total_ms_ = 0.0;
+    latency_samples_ = 0;
+}
+
+} // namespace TotalMixer
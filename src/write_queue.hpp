@@ -0,0 +1,115 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "alsa_backend.hpp"
+
+namespace TotalMixer {
+
+// Outbound ALSA write queue. Mixer edits are recorded here per control element, and a later
+// value for an element replaces a pending one (latest value wins), so a fader dragged at 60Hz
+// or an OSC controller streaming 500 messages a second costs at most one row write per flush.
+// A worker thread flushes whatever is pending at most rate() times per second, committing each
+// touched row with one ALSA write.
+//
+// Set() may be called from any thread and never waits on the hardware. With a rate of 0 there
+// is no worker: every Set() is written through immediately on the caller's thread.
+//
+// Pending elements are found through a flat table indexed by (row slot, element), so once each
+// row has been written the first time, queueing and flushing never allocate.
+class WriteQueue {
+public:
+    static constexpr int kDefaultRateHz = 100;
+
+    // Counters since Start() (or the last ResetStats()). Latency runs from the first Set() of a
+    // still-pending element to the end of the commit that wrote it, so a value that was
+    // overwritten while waiting is measured from its oldest unwritten change.
+    struct Stats {
+        size_t depth = 0;           // elements pending right now
+        size_t max_depth = 0;
+        uint64_t queued = 0;        // Set() calls
+        uint64_t coalesced = 0;     // Set() calls that replaced a pending value
+        uint64_t flushes = 0;       // commits issued
+        uint64_t row_writes = 0;    // rows written across all commits
+        uint64_t failed = 0;        // commits that reported an error
+        double avg_latency_ms = 0.0;
+        double max_latency_ms = 0.0;
+    };
+
+    WriteQueue();
+    ~WriteQueue();
+
+    WriteQueue(const WriteQueue&) = delete;
+    WriteQueue& operator=(const WriteQueue&) = delete;
+
+    // Attach to a backend and start the worker (if rate() > 0; SetRate() starts it later
+    // otherwise). Stop() flushes what is pending, joins the worker and detaches; call it before
+    // the backend goes away.
+    void Start(AlsaBackend* backend);
+    void Stop();
+
+    // Flushes per second; 0 = write-through. Takes effect immediately, also while running.
+    void SetRate(int hz);
+    int rate() const;
+
+    // Queue one element, or every edit of a transaction at once (a worker flush never sees half
+    // of it). The transaction is left untouched.
+    void Set(const ControlHandle& row, unsigned int element, long value);
+    void Set(const MatrixTransaction& txn);
+
+    // Write everything pending now, on the caller's thread. Returns false if a write failed.
+    bool Flush();
+
+    // True when nothing is pending or being written. Hardware reads taken while this is false
+    // may predate values the engine already shows.
+    bool idle() const;
+    Stats stats() const;
+    void ResetStats();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Widest row the mixer writes (a matrix row or the output volumes). Wider elements still
+    // queue, found by a scan of pending_ instead of the table.
+    static constexpr unsigned int kRowElements = 18;
+
+    struct Pending {
+        ControlHandle row;
+        unsigned int element = 0;
+        long value = 0;
+        Clock::time_point queued;
+        int key = -1;  // index_ entry, -1 if the element is not in the table
+    };
+
+    int KeyLocked(const ControlHandle& row, unsigned int element);
+    void Add(const ControlHandle& row, unsigned int element, long value, Clock::time_point now);
+    bool FlushLocked(std::unique_lock<std::mutex>& lock);
+    void StopLocked();
+    void StartWorkerLocked();
+    void WorkerMain();
+
+    AlsaBackend* backend_ = nullptr;
+    int rate_hz_ = kDefaultRateHz;
+
+    mutable std::mutex mtx_;
+    std::condition_variable cv_;
+    std::vector<Pending> pending_;
+    std::vector<int> row_by_numid_;  // numid -> row slot, -1 = not written yet this connection
+    std::vector<int> index_;         // row slot * kRowElements + element -> pending_ slot, -1 = none
+    std::vector<Pending> flushing_;  // swapped out by the flush in progress
+    MatrixTransaction txn_;
+    bool writing_ = false;
+    bool stop_ = false;
+    Stats stats_;
+    double latency_total_ms_ = 0.0;
+    uint64_t latency_samples_ = 0;
+
+    std::mutex worker_mtx_;  // serializes starting and joining worker_ (Start/Stop/SetRate)
+    std::thread worker_;
+};
+
+} // namespace TotalMixer